@@ -0,0 +1,31 @@
+// Generated by tools/seqgen.py from codes.txt (3 sequences, 13 states). Do not edit.
+#pragma once
+#include <KeypadSequences.h>
+
+#define SEQ_SERVICE 0  // *#06#
+#define SEQ_RESET 1  // *#99#
+#define SEQ_DOORBELL 2  // 0000
+
+const char ACCESS_CODES_ALPHABET[] PROGMEM = "#*069";
+
+const uint8_t ACCESS_CODES_NEXT[] PROGMEM = {
+      0,   1,   9,   0,   0,
+      2,   1,   9,   0,   0,
+      0,   1,   3,   0,   6,
+      0,   1,  10,   4,   0,
+      5,   1,   9,   0,   0,
+      0,   1,   9,   0,   0,
+      0,   1,   9,   0,   7,
+      8,   1,   9,   0,   0,
+      0,   1,   9,   0,   0,
+      0,   1,  10,   0,   0,
+      0,   1,  11,   0,   0,
+      0,   1,  12,   0,   0,
+      0,   1,  12,   0,   0,
+};
+
+const uint8_t ACCESS_CODES_OUTPUT[] PROGMEM = {
+    0, 0, 0, 0, 0, 1, 0, 0, 2, 0, 0, 0, 3
+};
+
+const KeypadAutomaton ACCESS_CODES = { ACCESS_CODES_ALPHABET, ACCESS_CODES_NEXT, ACCESS_CODES_OUTPUT, 5, 13 };
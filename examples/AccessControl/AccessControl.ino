@@ -0,0 +1,65 @@
+#include <CustomKeypad.h>
+#include <KeypadSequences.h>
+#include "AccessCodes.h" // regenerate with: python3 tools/seqgen.py codes.txt -o AccessCodes.h -n ACCESS_CODES
+
+#define ROWS 4
+#define COLS 3
+
+byte rowPins[ROWS] = {9, 8, 7, 6};
+byte colPins[COLS] = {5, 4, 3};
+
+char keys[ROWS][COLS] = {
+  {'1','2','3'},
+  {'4','5','6'},
+  {'7','8','9'},
+  {'*','0','#'}
+};
+
+char *keymap[ROWS] = {
+  keys[0], keys[1], keys[2], keys[3]
+};
+
+CustomKeypad keypad(keymap, rowPins, colPins, ROWS, COLS);
+KeypadSequences codes(ACCESS_CODES);
+KeypadPin pin('#', '*');
+
+void setup() {
+  Serial.begin(115200);
+  keypad.begin();
+
+  codes.setTimeout(3000);       // service codes must be typed without pauses
+  pin.setPin(0, "1234");
+  pin.setPin(1, "908172");
+  pin.setTimeout(5000);
+  pin.setLockout(3, 60000);     // 3 wrong PINs lock entry for a minute
+
+  Serial.println("CustomKeypad Access Control - enter PIN then #");
+}
+
+void loop() {
+  keypad.update();
+
+  KeyEvent ev;
+  while (keypad.readEvent(ev)) {
+    if (ev.type != KEY_PRESSED) continue;
+
+    switch (codes.feed(ev.key, ev.time)) {
+      case SEQ_SERVICE: Serial.println("Service menu"); break;
+      case SEQ_RESET:   Serial.println("Reset");        break;
+      case SEQ_DOORBELL: Serial.println("Ring");        break;
+    }
+
+    switch (pin.feed(ev.key, ev.time)) {
+      case PIN_ACCEPTED:
+        Serial.print("Door open for user ");
+        Serial.println(pin.getMatchedPin());
+        break;
+      case PIN_REJECTED:
+        Serial.println("Wrong PIN");
+        break;
+      case PIN_LOCKED:
+        Serial.println("Locked out");
+        break;
+    }
+  }
+}
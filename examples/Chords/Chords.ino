@@ -0,0 +1,50 @@
+#include <CustomKeypad.h>
+
+#define ROWS 4
+#define COLS 4
+
+byte rowPins[ROWS] = {9, 8, 7, 6};
+byte colPins[COLS] = {5, 4, 3, 2};
+
+char keys[ROWS][COLS] = {
+  {'1','2','3','A'},
+  {'4','5','6','B'},
+  {'7','8','9','C'},
+  {'*','0','#','D'}
+};
+
+char *keymap[ROWS] = {
+  keys[0], keys[1], keys[2], keys[3]
+};
+
+CustomKeypad keypad(keymap, rowPins, colPins, ROWS, COLS);
+KeypadChords chords(keypad);
+
+void setup() {
+  Serial.begin(115200);
+  keypad.begin();
+
+  chords.addChord("*#", 'S');   // service mode
+  chords.addChord("AD", 'R');   // reset
+  chords.setChordWindow(80);    // all keys down within 80 ms
+  keypad.setChords(&chords);
+
+  Serial.println("CustomKeypad Chords - press * and # together");
+}
+
+void loop() {
+  keypad.update();
+
+  KeyEvent ev;
+  while (keypad.readEvent(ev)) {
+    switch (ev.type) {
+      case KEY_PRESSED:  Serial.print("Pressed ");  break;
+      case KEY_RELEASED: Serial.print("Released "); break;
+      case KEY_HOLD:     Serial.print("Held ");     break;
+      case KEY_CHORD:    Serial.print("Chord ");    break;
+    }
+    Serial.print(ev.key);
+    Serial.print(" @ ");
+    Serial.println(ev.time);
+  }
+}
@@ -0,0 +1,22 @@
+// Generated by tools/t9pack.py from words.txt (24 words, 254 bytes). Do not edit.
+#pragma once
+#include <Arduino.h>
+
+const uint8_t T9_DICTIONARY[] PROGMEM = {
+    0x54, 0x39, 0x01, 0x00, 0x57, 0x00, 0x10, 0x00, 0x5d, 0x00, 0x70, 0x00, 0xc5, 0x00, 0xe9, 0x00,
+    0x19, 0x00, 0x18, 0x00, 0x36, 0x00, 0x4a, 0x00, 0x43, 0x00, 0x20, 0x00, 0x26, 0x00, 0x30, 0x00,
+    0x00, 0x01, 0x63, 0x61, 0x62, 0x00, 0x00, 0x02, 0x62, 0x61, 0x64, 0x00, 0x61, 0x63, 0x65, 0x00,
+    0x00, 0x01, 0x61, 0x63, 0x74, 0x00, 0x10, 0x00, 0x3a, 0x00, 0x20, 0x00, 0x3e, 0x00, 0x02, 0x00,
+    0x42, 0x00, 0x00, 0x01, 0x63, 0x6c, 0x6f, 0x73, 0x65, 0x00, 0x02, 0x00, 0x4e, 0x00, 0x02, 0x01,
+    0x56, 0x00, 0x61, 0x6e, 0x64, 0x00, 0x00, 0x01, 0x63, 0x6f, 0x64, 0x65, 0x00, 0x10, 0x00, 0x61,
+    0x00, 0x10, 0x00, 0x65, 0x00, 0x20, 0x00, 0x69, 0x00, 0x00, 0x01, 0x64, 0x6f, 0x6f, 0x72, 0x00,
+    0x72, 0x00, 0x7a, 0x00, 0x97, 0x00, 0xbb, 0x00, 0xc0, 0x00, 0x08, 0x00, 0x7e, 0x00, 0x28, 0x00,
+    0x84, 0x00, 0x90, 0x00, 0x10, 0x00, 0x88, 0x00, 0x00, 0x01, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x00,
+    0x00, 0x01, 0x68, 0x65, 0x6c, 0x70, 0x00, 0x10, 0x02, 0xa1, 0x00, 0x69, 0x6e, 0x00, 0x67, 0x6f,
+    0x00, 0x02, 0x00, 0xa5, 0x00, 0x00, 0x04, 0x67, 0x6f, 0x6f, 0x64, 0x00, 0x68, 0x6f, 0x6d, 0x65,
+    0x00, 0x67, 0x6f, 0x6e, 0x65, 0x00, 0x68, 0x6f, 0x6f, 0x64, 0x00, 0x00, 0x01, 0x69, 0x73, 0x00,
+    0x00, 0x01, 0x69, 0x74, 0x00, 0x32, 0x00, 0xcd, 0x00, 0xd5, 0x00, 0xda, 0x00, 0x00, 0x02, 0x6f,
+    0x66, 0x00, 0x6d, 0x65, 0x00, 0x00, 0x01, 0x6f, 0x6e, 0x00, 0x02, 0x00, 0xde, 0x00, 0x10, 0x00,
+    0xe2, 0x00, 0x00, 0x01, 0x6f, 0x70, 0x65, 0x6e, 0x00, 0x14, 0x00, 0xef, 0x00, 0xf9, 0x00, 0x02,
+    0x00, 0xf3, 0x00, 0x00, 0x01, 0x74, 0x68, 0x65, 0x00, 0x00, 0x01, 0x74, 0x6f, 0x00,
+};
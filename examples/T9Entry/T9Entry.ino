@@ -0,0 +1,57 @@
+#include <CustomKeypad.h>
+#include <KeypadT9.h>
+#include "T9Dictionary.h" // regenerate with: python3 tools/t9pack.py words.txt -o T9Dictionary.h
+
+#define ROWS 4
+#define COLS 3
+
+byte rowPins[ROWS] = {9, 8, 7, 6};
+byte colPins[COLS] = {5, 4, 3};
+
+// Phone layout: 2-9 letters, 0 space, * next word, # delete
+char keys[ROWS][COLS] = {
+  {'1','2','3'},
+  {'4','5','6'},
+  {'7','8','9'},
+  {'*','0','#'}
+};
+
+char *keymap[ROWS] = {
+  keys[0], keys[1], keys[2], keys[3]
+};
+
+CustomKeypad keypad(keymap, rowPins, colPins, ROWS, COLS);
+KeypadT9 t9(T9_DICTIONARY);
+
+void show() {
+  Serial.print(t9.getText());
+  Serial.print('[');
+  Serial.print(t9.getComposition());
+  Serial.println(']');
+}
+
+void setup() {
+  Serial.begin(115200);
+  keypad.begin();
+  t9.setMode(T9_MODE_PREDICTIVE);
+  Serial.println("CustomKeypad T9 - press 1 to toggle multi-tap/predictive");
+}
+
+void loop() {
+  static char lastKey = 0;
+  char key = keypad.getKey();
+  unsigned long now = millis();
+
+  if (key && key != lastKey) {
+    if (key == '1') {
+      t9.setMode(t9.getMode() == T9_MODE_PREDICTIVE ? T9_MODE_MULTITAP : T9_MODE_PREDICTIVE);
+      show();
+    }
+    else if (t9.handleKey(key, now)) {
+      show();
+    }
+  }
+  lastKey = key;
+
+  if (t9.poll(now)) show();
+}
@@ -0,0 +1,96 @@
+#pragma once
+/**
+ * @file Arduino.h
+ * @brief Host build of the Arduino API used by the library, for tests and benchmarks on a PC.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ *
+ * Time is simulated: `micros()` advances by HOST_PIN_US for every pin call and by the requested
+ * amount in `delayMicroseconds()`, so scan times measured on the host follow the pin traffic of
+ * the code under test. What is wired to the pins is supplied by a HostModel.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+typedef uint8_t byte;
+
+#define HIGH          1
+#define LOW           0
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+
+#define PROGMEM
+#define pgm_read_byte(p)   (*(const uint8_t *)(p))
+#define pgm_read_word(p)   (*(const uint16_t *)(p))
+#define pgm_read_dword(p)  (*(const uint32_t *)(p))
+#define strlen_P           strlen
+#define memcpy_P           memcpy
+
+#define bit(b)  (1UL << (b))  // as in the AVR core, so name clashes show up on the host too
+
+#define noInterrupts()
+#define interrupts()
+
+#ifndef HOST_PIN_US
+#define HOST_PIN_US  4  ///< Simulated cost of one pinMode/digitalWrite/digitalRead (AVR, 16 MHz).
+#endif
+
+#define HOST_MAX_PINS  64  ///< Pin numbers 0 .. HOST_MAX_PINS - 1.
+
+/**
+ * @brief Hardware wired to the simulated pins.
+ *
+ * `level()` returns what an input pin reads; `written()` sees every output change, e.g. the
+ * clock edges of a shift register.
+ */
+class HostModel {
+    public:
+        virtual ~HostModel() {}
+        virtual int level(uint8_t pin) = 0;
+        virtual void written(uint8_t pin, uint8_t value) { (void)pin; (void)value; }
+};
+
+namespace Host {
+    extern unsigned long us;         // simulated time
+    extern unsigned long pinCalls;   // pinMode, digitalWrite and digitalRead calls
+    extern uint8_t mode[HOST_MAX_PINS];
+    extern uint8_t value[HOST_MAX_PINS];
+    extern HostModel *model;
+}
+
+inline void pinMode(uint8_t pin, uint8_t mode)
+{
+    Host::us += HOST_PIN_US;
+    Host::pinCalls++;
+    Host::mode[pin] = mode;
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t value)
+{
+    Host::us += HOST_PIN_US;
+    Host::pinCalls++;
+    Host::value[pin] = value ? HIGH : LOW;
+    if (Host::model) Host::model->written(pin, Host::value[pin]);
+}
+
+inline int digitalRead(uint8_t pin)
+{
+    Host::us += HOST_PIN_US;
+    Host::pinCalls++;
+    if (Host::mode[pin] == OUTPUT) return Host::value[pin];
+    if (Host::model) return Host::model->level(pin);
+    return (Host::mode[pin] == INPUT_PULLUP) ? HIGH : LOW;
+}
+
+inline int analogRead(uint8_t pin)
+{
+    return Host::model ? Host::model->level(pin) : 0;
+}
+
+inline unsigned long micros() { return Host::us; }
+inline unsigned long millis() { return Host::us / 1000; }
+inline void delayMicroseconds(unsigned int us) { Host::us += us; }
+inline void delay(unsigned long ms) { Host::us += ms * 1000; }
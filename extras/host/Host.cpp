@@ -0,0 +1,19 @@
+/**
+ * @file Host.cpp
+ * @brief State of the simulated Arduino core and the default bus for host builds.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "Arduino.h"
+#include "Wire.h"
+
+namespace Host {
+    unsigned long us = 0;
+    unsigned long pinCalls = 0;
+    uint8_t mode[HOST_MAX_PINS];
+    uint8_t value[HOST_MAX_PINS];
+    HostModel *model = nullptr;
+}
+
+TwoWire Wire;
@@ -0,0 +1,100 @@
+#pragma once
+/**
+ * @file HostModels.h
+ * @brief Simulated keypad hardware for host builds: a matrix on direct pins and a matrix behind
+ *        74HC595 column drivers and 74HC165 row readers.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "Arduino.h"
+
+#define HOST_MATRIX_LINES  16  ///< Rows and columns per simulated matrix.
+
+/**
+ * @brief Key matrix wired directly to MCU pins.
+ *
+ * A pressed key joins its row and column pin. A pin that is read takes the level of a driven pin
+ * it is joined to, otherwise its pull: HIGH for INPUT_PULLUP, LOW for INPUT (the external
+ * pull-downs of KeypadPinDriver). Works for either scan orientation.
+ */
+class HostMatrix : public HostModel {
+    public:
+        bool keys[HOST_MATRIX_LINES][HOST_MATRIX_LINES] = {};
+
+        HostMatrix(const byte *rows, const byte *cols, byte numRows, byte numCols)
+            : _rows(rows), _cols(cols), _numRows(numRows), _numCols(numCols) {}
+
+        int level(uint8_t pin) override
+        {
+            for (byte r = 0; r < _numRows; r++) {
+                if (_rows[r] != pin) continue;
+                for (byte c = 0; c < _numCols; c++) {
+                    if (keys[r][c] && Host::mode[_cols[c]] == OUTPUT) return Host::value[_cols[c]];
+                }
+            }
+            for (byte c = 0; c < _numCols; c++) {
+                if (_cols[c] != pin) continue;
+                for (byte r = 0; r < _numRows; r++) {
+                    if (keys[r][c] && Host::mode[_rows[r]] == OUTPUT) return Host::value[_rows[r]];
+                }
+            }
+            return (Host::mode[pin] == INPUT_PULLUP) ? HIGH : LOW;
+        }
+
+    private:
+        const byte *_rows;
+        const byte *_cols;
+        byte _numRows;
+        byte _numCols;
+};
+
+/**
+ * @brief Key matrix with columns on chained 74HC595s and rows on chained 74HC165s.
+ *
+ * Wired as KeypadShiftRegister expects: 595 output c drives column c, the rows have pull-downs
+ * and row 0 is the first bit shifted out of QH. The 595 shifts on SRCLK rising edges and copies
+ * to its outputs on RCLK rising edges; the 165 loads the rows while SH/LD is LOW and shifts on CLK
+ * rising edges.
+ */
+class HostShiftRegister : public HostModel {
+    public:
+        bool keys[HOST_MATRIX_LINES][HOST_MATRIX_LINES] = {};
+
+        HostShiftRegister(byte dataOut, byte clockOut, byte latchOut,
+                          byte dataIn, byte clockIn, byte loadIn, byte numRows, byte numCols)
+            : _dataOut(dataOut), _clockOut(clockOut), _latchOut(latchOut),
+              _dataIn(dataIn), _clockIn(clockIn), _loadIn(loadIn),
+              _numRows(numRows), _numCols(numCols) {}
+
+        int level(uint8_t pin) override
+        {
+            return (pin == _dataIn) ? (_rows & 1) : LOW;
+        }
+
+        void written(uint8_t pin, uint8_t value) override
+        {
+            if (pin == _clockOut && value) _shift = (_shift << 1) | Host::value[_dataOut];
+            if (pin == _latchOut && value) _outputs = _shift;
+            if (pin == _loadIn && !value) _rows = sense();
+            if (pin == _clockIn && value && Host::value[_loadIn]) _rows >>= 1;
+        }
+
+    private:
+        byte _dataOut, _clockOut, _latchOut, _dataIn, _clockIn, _loadIn;
+        byte _numRows, _numCols;
+        uint32_t _shift = 0;    // 595 shift stage
+        uint32_t _outputs = 0;  // 595 outputs, bit c drives column c
+        uint32_t _rows = 0;     // 165 chain, bit 0 is on QH
+
+        uint32_t sense()
+        {
+            uint32_t rows = 0;
+            for (byte r = 0; r < _numRows; r++) {
+                for (byte c = 0; c < _numCols; c++) {
+                    if (keys[r][c] && (_outputs & ((uint32_t)1 << c))) rows |= (uint32_t)1 << r;
+                }
+            }
+            return rows;
+        }
+};
@@ -0,0 +1,112 @@
+#pragma once
+/**
+ * @file Wire.h
+ * @brief Host stand-in for the Arduino TwoWire bus that emulates a keypad expander and counts
+ *        bus transactions.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "Arduino.h"
+
+#define HOST_EXPANDER_LINES  8  ///< Pins per port of the emulated expander.
+
+/**
+ * @brief TwoWire-compatible bus with one emulated MCP23017 or PCF8574 and a key matrix on it.
+ *
+ * The wiring matches KeypadMCP23017 (columns on port A, rows on port B) and KeypadPCF8574
+ * (columns on P0.., rows on the following pins). Set `keys[row][col]` to press a key. Every
+ * transaction that ends with a STOP is counted, as a write (`endTransmission()`) or a read
+ * (`requestFrom()`); a register pointer written with a repeated start belongs to the read that
+ * follows it.
+ */
+class TwoWire {
+    public:
+        enum Chip { MCP23017, PCF8574 };
+
+        Chip chip;
+        byte numCols = 4;  // PCF8574 only: rows start at pin numCols
+        bool keys[HOST_EXPANDER_LINES][HOST_EXPANDER_LINES] = {};
+
+        unsigned long writes = 0;  // write transactions
+        unsigned long reads = 0;   // read transactions
+
+        TwoWire(Chip chip = MCP23017) : chip(chip)
+        {
+            memset(_regs, 0, sizeof(_regs));
+            _regs[0x00] = _regs[0x01] = 0xFF;  // power-on: all pins inputs
+        }
+
+        void begin() {}
+
+        void beginTransmission(uint8_t address)
+        {
+            (void)address;
+            _pending = 0;
+        }
+
+        size_t write(uint8_t data)
+        {
+            if (chip == PCF8574) _latch = data;
+            else if (_pending++ == 0) _pointer = data;
+            else _regs[_pointer++ % sizeof(_regs)] = data;
+            return 1;
+        }
+
+        uint8_t endTransmission(bool stop = true)
+        {
+            if (stop) writes++;
+            return 0;
+        }
+
+        uint8_t requestFrom(uint8_t address, uint8_t count)
+        {
+            (void)address;
+            reads++;
+            _available = count;
+            return count;
+        }
+
+        int read()
+        {
+            if (!_available) return -1;
+            _available--;
+            if (chip == PCF8574) return pcfPins();
+            return (_pointer == 0x13) ? mcpPortB() : _regs[_pointer % sizeof(_regs)];
+        }
+
+        void resetCounters() { writes = reads = 0; }
+
+    private:
+        uint8_t _regs[0x16];    // MCP23017 registers, IOCON.BANK = 0
+        uint8_t _pointer = 0;
+        uint8_t _pending = 0;
+        uint8_t _latch = 0xFF;  // PCF8574 output latch
+        uint8_t _available = 0;
+
+        // A row reads LOW when a pressed key joins it to a column driven LOW.
+        uint8_t mcpPortB()
+        {
+            uint8_t level = 0xFF;
+            for (byte c = 0; c < HOST_EXPANDER_LINES; c++) {
+                bool driven = !(_regs[0x00] & (1 << c)) && !(_regs[0x14] & (1 << c));
+                for (byte r = 0; driven && r < HOST_EXPANDER_LINES; r++) {
+                    if (keys[r][c]) level &= ~(1 << r);
+                }
+            }
+            return level;
+        }
+
+        uint8_t pcfPins()
+        {
+            uint8_t level = _latch;
+            for (byte c = 0; c < numCols; c++) {
+                for (byte r = 0; !(_latch & (1 << c)) && r + numCols < 8; r++) {
+                    if (keys[r][c]) level &= ~(1 << (r + numCols));
+                }
+            }
+            return level;
+        }
+};
+
+extern TwoWire Wire;
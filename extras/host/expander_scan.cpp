@@ -0,0 +1,72 @@
+/**
+ * @file expander_scan.cpp
+ * @brief Host check of the I2C expander backends: keys are found and each column costs at most
+ *        one write and one read transaction.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ *
+ * Build and run from the repository root:
+ *
+ *     g++ -std=gnu++11 -Iextras/host -Isrc extras/host/Host.cpp extras/host/expander_scan.cpp \
+ *         src/CustomKeypad.cpp src/Keypad*.cpp -o expander_scan && ./expander_scan
+ */
+
+#include <stdio.h>
+#include <CustomKeypad.h>
+#include <KeypadExpander.h>
+
+#define ROWS 4
+#define COLS 4
+
+static char row0[] = "123A", row1[] = "456B", row2[] = "789C", row3[] = "*0#D";
+static char *keymap[ROWS] = { row0, row1, row2, row3 };
+
+/**
+ * @brief Scans one keypad through an expander and checks keys and bus traffic.
+ *
+ * @param name Backend name for the report.
+ * @param keypad The keypad, scanning through `bus`.
+ * @param bus The emulated bus.
+ * @return bool True if every check passed.
+ */
+static bool check(const char *name, CustomKeypad &keypad, TwoWire &bus)
+{
+    bool ok = true;
+    char keys[ROWS * COLS];
+
+    keypad.begin();
+    bus.keys[1][2] = true;  // '6'
+    bus.keys[3][0] = true;  // '*'
+
+    for (int pass = 0; pass < 3; pass++) {
+        delay(100);  // past the debounce time
+        bus.resetCounters();
+        keypad.update();
+
+        printf("%-9s pass %d: %lu writes, %lu reads for %d columns\n", name, pass, bus.writes,
+               bus.reads, COLS);
+        if (bus.writes > COLS || bus.reads > COLS) ok = false;
+    }
+
+    byte n = keypad.getKeys(keys, sizeof(keys));
+    bool found = (n == 2 && keypad.isPressed('6') && keypad.isPressed('*'));
+    printf("%-9s keys: %.*s %s\n", name, n, keys, found ? "" : "(expected 6 and *)");
+
+    printf("%-9s %s\n", name, (ok && found) ? "PASS" : "FAIL");
+    return ok && found;
+}
+
+int main()
+{
+    KeypadMCP23017<> mcp(Wire);
+    CustomKeypad mcpPad(keymap, mcp, ROWS, COLS);
+
+    TwoWire pcfBus(TwoWire::PCF8574);
+    pcfBus.numCols = COLS;
+    KeypadPCF8574<> pcf(pcfBus);
+    CustomKeypad pcfPad(keymap, pcf, ROWS, COLS);
+
+    bool ok = check("MCP23017", mcpPad, Wire);
+    ok = check("PCF8574", pcfPad, pcfBus) && ok;
+    return ok ? 0 : 1;
+}
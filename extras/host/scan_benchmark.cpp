@@ -0,0 +1,86 @@
+/**
+ * @file scan_benchmark.cpp
+ * @brief Host benchmark of a full 8x16 matrix scan on direct pins and through 74HC595/74HC165
+ *        shift registers.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ *
+ * Build and run from the repository root (128 keys need a larger key bitmap):
+ *
+ *     g++ -std=gnu++11 -DKEYPAD_MAX_KEYS=128 -Iextras/host -Isrc extras/host/Host.cpp \
+ *         extras/host/scan_benchmark.cpp src/CustomKeypad.cpp src/Keypad*.cpp -o scan_benchmark
+ *
+ * Times are simulated from the pin traffic, at HOST_PIN_US per pin call plus the settle waits.
+ * They model boards where pins go through digitalWrite/digitalRead; on AVR the shift register
+ * backend writes the port registers directly, so its scans are faster there than shown.
+ */
+
+#include <stdio.h>
+#include <CustomKeypad.h>
+#include <KeypadShiftRegister.h>
+#include "HostModels.h"
+
+#define ROWS   8
+#define COLS   16
+#define SCANS  100
+
+static char keyRows[ROWS][COLS + 1];
+static char *keymap[ROWS];
+
+static const byte pressed[][2] = { {0, 0}, {3, 7}, {7, 15} };  // row, column
+#define NUM_PRESSED  (sizeof(pressed) / sizeof(pressed[0]))
+
+/**
+ * @brief Presses the benchmark keys, checks they are found and times idle scans.
+ *
+ * @param name Backend name for the report.
+ * @param keypad The keypad under test, already started.
+ * @param keys The key array of the active hardware model.
+ * @return bool True if exactly the pressed keys were found.
+ */
+static bool bench(const char *name, CustomKeypad &keypad, bool (*keys)[HOST_MATRIX_LINES])
+{
+    char found[ROWS * COLS];
+
+    for (byte k = 0; k < NUM_PRESSED; k++) keys[pressed[k][0]][pressed[k][1]] = true;
+    delay(100);
+    byte n = keypad.getKeys(found, sizeof(found));
+
+    bool ok = (n == NUM_PRESSED);
+    for (byte k = 0; k < NUM_PRESSED && ok; k++) {
+        ok = keypad.isPressed(keymap[pressed[k][0]][pressed[k][1]]);
+    }
+
+    unsigned long start = micros();
+    unsigned long calls = Host::pinCalls;
+    for (int i = 0; i < SCANS; i++) keypad.update();
+
+    printf("%-15s %7lu us/scan %6lu pin calls/scan  keys %s\n", name, (micros() - start) / SCANS,
+           (Host::pinCalls - calls) / SCANS, ok ? "ok" : "WRONG");
+    return ok;
+}
+
+int main()
+{
+    for (byte r = 0; r < ROWS; r++) {
+        for (byte c = 0; c < COLS; c++) keyRows[r][c] = '!' + r * COLS + c;
+        keymap[r] = keyRows[r];
+    }
+
+    byte rowPins[ROWS] = { 2, 3, 4, 5, 6, 7, 8, 9 };
+    byte colPins[COLS] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25 };
+    HostMatrix matrix(rowPins, colPins, ROWS, COLS);
+    Host::model = &matrix;
+    CustomKeypad direct(keymap, rowPins, colPins, ROWS, COLS);
+    direct.begin();
+    bool ok = bench("direct pins", direct, matrix.keys);
+
+    KeypadShiftRegister shifter(40, 41, 42, 43, 44, 45);
+    HostShiftRegister chain(40, 41, 42, 43, 44, 45, ROWS, COLS);
+    Host::model = &chain;
+    CustomKeypad shifted(keymap, shifter, ROWS, COLS);
+    shifted.begin();
+    ok = bench("shift register", shifted, chain.keys) && ok;
+
+    return ok ? 0 : 1;
+}
@@ -19,92 +19,380 @@
  * @param numRows Number of rows in the keypad matrix.
  * @param numCols Number of columns in the keypad matrix.
  * @return None
+ * @note Keys with an index of `KEYPAD_MAX_KEYS` or more, and lines past `KEYPAD_MAX_STROBES`
+ *       strobed or `KEYPAD_MAX_LINES` sensed, are not scanned and `begin()` returns false;
+ *       raise those limits for larger matrices.
  */
 CustomKeypad::CustomKeypad(char **userKeymap, byte *rowPins, byte *colPins, byte numRows, byte numCols)
+    : _pins(rowPins, colPins)
 {
     _keymap  = userKeymap;
-    _rows    = rowPins;
-    _cols    = colPins;
+    _driver  = &_pins;
     _numRows = numRows;
     _numCols = numCols;
 }
 
 /**
- * @brief Initializes the keypad by configuring pin modes for rows and columns.
+ * @brief Constructs a CustomKeypad object that scans through a custom driver.
  *
- * Sets column pins as outputs and initializes them to LOW. Sets row pins as inputs for
- * detecting key presses.
+ * Used for matrices behind GPIO expanders or other hardware that is not wired to MCU pins
+ * directly. Debouncing, events and keymaps behave exactly as with direct pins.
+ *
+ * @param userKeymap 2D array representing the keypad character map.
+ * @param driver Driver that selects columns and reads rows, e.g. KeypadMCP23017.
+ * @param numRows Number of rows in the keypad matrix.
+ * @param numCols Number of columns in the keypad matrix.
+ * @return None
+ * @note Keys with an index of `KEYPAD_MAX_KEYS` or more, and lines past `KEYPAD_MAX_STROBES`
+ *       strobed or `KEYPAD_MAX_LINES` sensed, are not scanned and `begin()` returns false;
+ *       raise those limits for larger matrices.
+ */
+CustomKeypad::CustomKeypad(char **userKeymap, KeypadDriver &driver, byte numRows, byte numCols)
+    : _pins(nullptr, nullptr)
+{
+    _keymap  = userKeymap;
+    _driver  = &driver;
+    _numRows = numRows;
+    _numCols = numCols;
+}
+
+/**
+ * @brief Initializes the keypad hardware.
+ *
+ * With direct pins, sets column pins as outputs initialized to LOW and row pins as inputs.
+ * Other drivers configure their own hardware. The scan orientation is fixed here: when rows are
+ * strobed, the driver is told to swap its lines and sees a `numCols x numRows` matrix. Keymap
+ * entries set to NO_KEY mark unpopulated positions, which are never scanned. Keys past the
+ * compile-time limits (`KEYPAD_MAX_KEYS` keys, `KEYPAD_MAX_STROBES` strobed and
+ * `KEYPAD_MAX_LINES` sensed lines) cannot be scanned either, which is reported by the return
+ * value; raise the limits with build flags for larger matrices.
  *
  * @param None
+ * @return bool True if every key of the matrix is scanned, false if the matrix exceeds a limit.
+ * @note Calls `KeypadDriver::begin()`.
+ */
+bool CustomKeypad::begin()
+{
+    if (_group) return true;  // the group configures the shared lines
+
+    bool transpose = (_orientation == KEYPAD_STROBE_ROWS) ||
+                     (_orientation == KEYPAD_STROBE_AUTO && _numRows < _numCols);
+    _transposed = _driver->setTransposed(transpose) && transpose;
+    buildScanMask();
+
+    if (_transposed) _driver->begin(_numCols, _numRows);
+    else _driver->begin(_numRows, _numCols);
+
+    byte sensed = _transposed ? _numCols : _numRows;
+    byte strobed = _transposed ? _numRows : _numCols;
+    return keyCount() == (unsigned int)_numRows * _numCols &&
+           strobed <= KEYPAD_MAX_STROBES && sensed <= KEYPAD_MAX_LINES;
+}
+
+/**
+ * @brief Scans the whole keypad matrix into a bitmap.
+ *
+ * Selects each column in sequence through the driver, reads all rows at once and sets the bit
+ * `row * numCols + col` for every pressed key. All keys are sampled, so simultaneous presses are
+ * seen together. A transposed scan strobes the rows and reads the columns instead; the bitmap
+ * keeps the same layout, so nothing past the scan sees the difference.
+ *
+ * The scan is pipelined: as soon as a column's rows are read, the next column is selected, and
+ * the rows just read are merged into the bitmap while it settles. Only the part of the settle
+ * time not covered by that work is spent waiting.
+ *
+ * With `setHotScan()`, passes between full sweeps only visit hot lines; keys on lines left out
+ * keep their debounced state.
+ *
+ * @param raw Bitmap receiving the undebounced key state.
  * @return None
- * @note Uses Arduino `pinMode` and `digitalWrite` functions.
+ * @note Relies on the member variables `_driver` and `_transposed`. Uses Arduino `micros`.
  */
-void CustomKeypad::begin()
+void CustomKeypad::scanMatrix(KeypadBitmap &raw)
 {
-    for (byte c = 0; c < _numCols; c++) {
-        pinMode(_cols[c], OUTPUT);
-        digitalWrite(_cols[c], LOW);
+    byte strobes = strobeCount();
+    bool sweep = beginPass(raw);
+    _driver->beginScan();
+
+    byte s = nextStrobe(0, sweep);
+    if (s >= strobes) return;
+
+    _driver->select(s);
+    unsigned long selectedAt = micros();
+
+    while (s < strobes) {
+        _driver->waitSettled(s, selectedAt);
+        KeypadLineMask lines = _driver->read() & _scanMask[s];
+        _driver->deselect(s);
+
+        byte next = nextStrobe(s + 1, sweep);
+        if (next < strobes) {
+            _driver->select(next);
+            selectedAt = micros();
+        }
+
+        // merge line s while the next line settles
+        mergeStrobe(raw, s, lines, sweep);
+        s = next;
     }
-    
-    for (byte r = 0; r < _numRows; r++) {
-        pinMode(_rows[r], INPUT);
+}
+
+/**
+ * @brief Starts a scan pass and decides whether it is a full sweep.
+ *
+ * Without `setHotScan()` every pass is a full sweep. A full sweep starts from an empty bitmap;
+ * any other pass starts from the debounced state, so lines left out keep their keys.
+ *
+ * @param raw Bitmap receiving the undebounced key state.
+ * @return bool True if every line is scanned in this pass.
+ * @note Updates the member variable `_pass`.
+ */
+bool CustomKeypad::beginPass(KeypadBitmap &raw)
+{
+    bool sweep = true;
+
+    if (_sweepEvery) {
+        sweep = (++_pass >= _sweepEvery);
+        if (sweep) _pass = 0;
     }
+
+    if (sweep) raw.clear();
+    else raw = _state;
+    return sweep;
 }
 
 /**
- * @brief Scans the keypad matrix to detect a single key press.
+ * @brief Tells whether a strobed line is visited in the current pass.
  *
- * Activates each column in sequence, checks for HIGH signals on row pins to detect a key press,
- * and returns the corresponding character from the keymap. Returns 0 if no key is pressed.
+ * @param strobe The strobed line, below `strobeCount()`.
+ * @param sweep True for a full sweep; otherwise only hot lines are visited.
+ * @return bool True if the line has scanned keys and is due in this pass.
+ */
+bool CustomKeypad::scansStrobe(byte strobe, bool sweep)
+{
+    return _scanMask[strobe] && (sweep || _heat[strobe]);
+}
+
+/**
+ * @brief Merges the lines read for one strobe and updates its heat.
+ *
+ * @param raw Bitmap receiving the undebounced key state.
+ * @param strobe The strobed line.
+ * @param lines Lines read at the active level.
+ * @param sweep True for a full sweep, whose bitmap starts empty.
+ * @return None
+ * @note Updates the member variable `_heat`.
+ */
+void CustomKeypad::mergeStrobe(KeypadBitmap &raw, byte strobe, KeypadLineMask lines, bool sweep)
+{
+    if (!sweep) clearLines(raw, strobe);
+    mergeLines(raw, strobe, lines);
+    if (lines & _scanMask[strobe]) _heat[strobe] = _hotPasses;
+    else if (_heat[strobe]) _heat[strobe]--;
+}
+
+/**
+ * @brief Returns the number of key indices that fit the key bitmaps.
  *
  * @param None
- * @return char The character of the pressed key, or 0 if no key is pressed.
- * @note Uses Arduino `digitalWrite`, `digitalRead`, and `delayMicroseconds` functions.
+ * @return unsigned int `numRows * numCols`, at most KEYPAD_MAX_KEYS.
  */
-char CustomKeypad::scanKeypad()
+unsigned int CustomKeypad::keyCount()
 {
-    for (byte c = 0; c < _numCols; c++) {
-        digitalWrite(_cols[c], HIGH);
-        delayMicroseconds(10); // settle
+    unsigned int count = (unsigned int)_numRows * _numCols;
+    return (count > KEYPAD_MAX_KEYS) ? KEYPAD_MAX_KEYS : count;
+}
 
-        for (byte r = 0; r < _numRows; r++) {
-            if (digitalRead(_rows[r]) == HIGH) {
-                digitalWrite(_cols[c], LOW);   // restore before returning
-                return _keymap[r][c];
-            }
+/**
+ * @brief Returns the number of lines strobed per scan.
+ *
+ * Lines past KEYPAD_MAX_STROBES are not scanned, so the per-strobe tables stay in bounds.
+ *
+ * @param None
+ * @return byte Columns, or rows when the scan is transposed, at most KEYPAD_MAX_STROBES.
+ */
+byte CustomKeypad::strobeCount()
+{
+    byte count = _transposed ? _numRows : _numCols;
+    return (count > KEYPAD_MAX_STROBES) ? KEYPAD_MAX_STROBES : count;
+}
+
+/**
+ * @brief Finds the next strobed line with keys to read in this pass.
+ *
+ * @param from First strobed line to consider.
+ * @param sweep True for a full sweep; otherwise only hot lines are visited.
+ * @return byte The strobed line, or `strobeCount()` if none is left.
+ */
+byte CustomKeypad::nextStrobe(byte from, bool sweep)
+{
+    byte strobes = strobeCount();
+    for (; from < strobes; from++) {
+        if (scansStrobe(from, sweep)) break;
+    }
+    return from;
+}
+
+/**
+ * @brief Clears the scanned keys of one strobed line in the bitmap.
+ *
+ * @param raw Bitmap holding the undebounced key state.
+ * @param strobe The strobed line.
+ * @return None
+ */
+void CustomKeypad::clearLines(KeypadBitmap &raw, byte strobe)
+{
+    for (KeypadLineMask lines = _scanMask[strobe]; lines; lines &= lines - 1) {
+        byte line = __builtin_ctzl(lines);
+        raw.reset(_transposed ? strobe * _numCols + line : line * _numCols + strobe);
+    }
+}
+
+/**
+ * @brief Builds the per-strobe masks of the keys that are scanned.
+ *
+ * A position is scanned when its keymap entry is not NO_KEY, it is not disabled with
+ * `setEnabledKeys()`, it is not a priority key and it fits the key bitmap and line mask. The
+ * strobe and line of each priority key are resolved here too. Lines with no such key are
+ * skipped entirely and other positions are masked off, so floating or unconnected pads never show
+ * up in the bitmap.
+ *
+ * @param None
+ * @return None
+ * @note Updates the member variable `_scanMask`.
+ */
+void CustomKeypad::buildScanMask()
+{
+    memset(_scanMask, 0, sizeof(_scanMask));
+
+    for (byte r = 0; r < _numRows; r++) {
+        for (byte c = 0; c < _numCols; c++) {
+            unsigned int index = r * _numCols + c;
+            byte strobe = _transposed ? r : c;
+            byte line = _transposed ? c : r;
+            if (index >= keyCount() || strobe >= KEYPAD_MAX_STROBES) continue;
+            if (line >= KEYPAD_MAX_LINES || _keymap[r][c] == NO_KEY) continue;
+            if (_disabled.test(index) || _priorityKeys.test(index)) continue;
+            _scanMask[strobe] |= (KeypadLineMask)1 << line;
         }
+    }
 
-        digitalWrite(_cols[c], LOW);
+    for (byte p = 0; p < _priorityCount; p++) {
+        byte r = _priority[p].index / _numCols;
+        byte c = _priority[p].index % _numCols;
+        byte strobe = _transposed ? r : c;
+        byte line = _transposed ? c : r;
+        bool fits = (strobe < KEYPAD_MAX_STROBES && line < KEYPAD_MAX_LINES);
+        _priority[p].strobe = strobe;
+        _priority[p].line = fits ? (KeypadLineMask)1 << line : 0;
     }
-    return 0; 
 }
 
 /**
- * @brief Retrieves the current key with debouncing and hold detection.
+ * @brief Sets the keys read on one strobed line into the bitmap.
+ *
+ * Positions outside the scan mask are dropped.
+ *
+ * @param raw Bitmap receiving the undebounced key state.
+ * @param strobe The strobed line (a column, or a row when transposed).
+ * @param lines The sensed lines read for it.
+ * @return None
+ */
+void CustomKeypad::mergeLines(KeypadBitmap &raw, byte strobe, KeypadLineMask lines)
+{
+    lines &= _scanMask[strobe];
+
+    if (_transposed) {
+        for (; lines; lines &= lines - 1) raw.set(strobe * _numCols + __builtin_ctzl(lines));
+    } else {
+        for (; lines; lines &= lines - 1) raw.set(__builtin_ctzl(lines) * _numCols + strobe);
+    }
+}
+
+/**
+ * @brief Scans the keypad, debounces the matrix and generates key events.
  *
- * Scans the keypad for a key press, applies debouncing to filter noise, and detects hold events
- * based on the configured hold time. Notifies the event listener if registered.
+ * Priority keys are polled first. A keypad that belongs to a KeypadGroup scans the whole group
+ * instead, since its rows are shared.
  *
  * @param None
- * @return char The character of the currently pressed key, or 0 if no key is pressed.
- * @note Uses Arduino `millis` function for timing, and relies on member variables `_lastKey`,
- *       `_lastChange`, `_pressStart`, `_holding`, `_keyState`, `_debounceTime`, `_holdTime`,
- *       and `_eventListener`.
+ * @return bool True if the debounced matrix changed.
+ * @note Uses Arduino `millis` function for timing. `getKey()` and `getKeys()` call this.
  */
-char CustomKeypad::getKey()
+bool CustomKeypad::update()
 {
-    char key = scanKeypad();
-    unsigned long now = millis();
+    if (_group) return _group->update(*this);
 
-    if (key != _lastKey) {
+    pollPriority();
+
+    KeypadBitmap raw;
+    _scanning = true;
+    scanMatrix(raw);
+    _scanning = false;
+    return process(raw, millis());
+}
+
+/**
+ * @brief Debounces a scanned matrix and generates key events.
+ *
+ * A key change is accepted immediately unless that key already changed within `_debounceTime`,
+ * so bounce is filtered per key while other keys stay responsive. Each key keeps its own change
+ * time, so activity on other keys never extends its lock. Each key that changed produces a
+ * KEY_PRESSED or KEY_RELEASED event (releases first), routed through the chord matcher when one
+ * is attached and then queued for `readEvent()`, followed by the hold and repeat events of held
+ * keys. The key reported by `getKey()` is chosen by the `setKeyPolicy()` policy; its press,
+ * release and hold are also passed to the event listener as before.
+ *
+ * @param raw Undebounced key state from the scan.
+ * @param now Scan time in milliseconds.
+ * @return bool True if the debounced matrix changed.
+ */
+bool CustomKeypad::process(const KeypadBitmap &raw, unsigned long now)
+{
+    bool changed = false;
+
+    if (_locked.any()) {
         if (now - _lastChange > _debounceTime) {
-            _lastChange = now;
-            _pressStart = now;
-            _holding = false;
-            _keyState = (key ? KEY_PRESSED : KEY_RELEASED);
-            if (_eventListener) _eventListener(key);
+            _locked.clear();  // every lock is older than the newest one
+        } else {
+            for (int i = _locked.first(); i >= 0; i = _locked.next(i)) {
+                if ((unsigned int)now - _changedAt[i] > _debounceTime) _locked.reset(i);
+            }
+        }
+    }
+
+    KeypadBitmap diff = (raw ^ _state).andNot(_locked);
+    if (diff.any()) {
+        KeypadBitmap released = diff.andNot(raw);
+        KeypadBitmap pressed = diff & raw;
+        _lastChange = now;
+        _locked |= diff;
+        _state = _state ^ diff;
+        changed = true;
+
+        for (int i = diff.first(); i >= 0; i = diff.next(i)) _changedAt[i] = now;
+
+        for (int i = released.first(); i >= 0; i = released.next(i)) {
+            KeyEvent ev = { KEY_RELEASED, (KeypadKeyIndex)i, heldKey(i), now };
+            route(ev);
+        }
+        for (int i = pressed.first(); i >= 0; i = pressed.next(i)) {
+            KeyEvent ev = { KEY_PRESSED, (KeypadKeyIndex)i, resolveKey(i), now };
+            route(ev);
         }
     }
+
+    if (_chords) _chords->poll(now);
+    updateHeld(now);
+
+    char key = primaryKey();
+
+    if (key != _lastKey) {
+        _pressStart = now;
+        _holding = false;
+        _keyState = (key ? KEY_PRESSED : KEY_RELEASED);
+        if (_eventListener) _eventListener(key);
+    }
     else if (key && !_holding && (now - _pressStart >= _holdTime)) {
         _keyState = KEY_HOLD;
         _holding = true;
@@ -112,40 +400,258 @@ char CustomKeypad::getKey()
     }
 
     _lastKey = key;
-    return key;
+    return changed;
+}
+
+/**
+ * @brief Retrieves the current key with debouncing and hold detection.
+ *
+ * Updates the keypad and returns the key currently pressed. When several keys are down, the key
+ * is chosen by the `setKeyPolicy()` policy: by default the first one in scan order (first
+ * column, then first row).
+ *
+ * @param None
+ * @return char The character of the currently pressed key, or 0 if no key is pressed.
+ * @note Relies on `update()` for scanning, debouncing and listener notification.
+ */
+char CustomKeypad::getKey()
+{
+    update();
+    return _lastKey;
 }
 
 /**
- * @brief Scans the keypad for multiple key presses and stores them in a buffer.
+ * @brief Retrieves every pressed key and stores them in a buffer.
  *
- * Activates each column in sequence, checks for HIGH signals on row pins, and stores the
- * corresponding characters in the provided buffer up to the specified maximum.
+ * Updates the keypad and copies the characters of the held keys, in index order, to the provided
+ * buffer up to the specified maximum. The keys are those whose press `readEvent()` has reported:
+ * priority keys are included, while modifier keys, layer keys and chord keys held back or
+ * consumed by a chord are not. Each key reports the character it was pressed with.
  *
  * @param keysBuffer Buffer to store the characters of pressed keys.
  * @param maxKeys Maximum number of keys to store in the buffer.
  * @return byte The number of keys detected and stored in the buffer.
- * @note Uses Arduino `digitalWrite`, `digitalRead`, and `delayMicroseconds` functions.
+ * @note Relies on `update()` and `reportedKeys()`.
  */
 byte CustomKeypad::getKeys(char *keysBuffer, byte maxKeys)
 {
     byte count = 0;
+    update();
+
+    KeypadBitmap keys = reportedKeys();
+    for (int i = keys.first(); i >= 0 && count < maxKeys; i = keys.next(i)) {
+        keysBuffer[count++] = _priorityKeys.test(i) ? keyAt(i) : heldKey(i);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Collects the held keys whose press has been reported as an event.
+ *
+ * @param None
+ * @return KeypadBitmap The delivered presses plus the priority keys that are down.
+ * @note Relies on the member variables `_reported` and `_priority`.
+ */
+KeypadBitmap CustomKeypad::reportedKeys()
+{
+    KeypadBitmap keys = _reported;
+    for (byte p = 0; p < _priorityCount; p++) {
+        if (_priority[p].down) keys.set(_priority[p].index);
+    }
+    return keys;
+}
+
+/**
+ * @brief Retrieves the next queued key event.
+ *
+ * Events are produced by `update()` (also called from `getKey()` and `getKeys()`) and carry the
+ * key index, character and timestamp. Unlike the listener, every key is reported.
+ *
+ * @param event Receives the oldest queued event.
+ * @return bool True if an event was available.
+ */
+bool CustomKeypad::readEvent(KeyEvent &event)
+{
+    noInterrupts();
+    bool priority = _priorityEvents.pop(event);
+    interrupts();
+
+    return priority || _events.pop(event);
+}
+
+/**
+ * @brief Retrieves the debounced state of every key.
+ *
+ * @param None
+ * @return const KeypadBitmap& Bitmap with bit `row * numCols + col` set for each pressed key.
+ */
+const KeypadBitmap &CustomKeypad::getKeyBitmap()
+{
+    return _state;
+}
+
+/**
+ * @brief Looks up the index of a key character in the keymap.
+ *
+ * @param key The key character.
+ * @return int The key index `row * numCols + col`, or -1 if the key is not in the keymap or its
+ *         index is past KEYPAD_MAX_KEYS.
+ */
+int CustomKeypad::findKey(char key)
+{
+    for (unsigned int i = 0; i < keyCount(); i++) {
+        if (_keymap[i / _numCols][i % _numCols] == key) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Retrieves the keymap character of a key index.
+ *
+ * @param index The key index `row * numCols + col`.
+ * @return char The key character.
+ */
+char CustomKeypad::keyAt(KeypadKeyIndex index)
+{
+    return _keymap[index / _numCols][index % _numCols];
+}
+
+/**
+ * @brief Resolves the character of a key through the held modifiers and the layer stack.
+ *
+ * @param index The key index `row * numCols + col`.
+ * @return char The character from the keymap of a held modifier, otherwise the character of the
+ *         key on the highest active layer, or the base keymap character when neither is attached.
+ */
+char CustomKeypad::resolveKey(KeypadKeyIndex index)
+{
+    if (_modifiers) {
+        char c = _modifiers->resolve(index, _state);
+        if (c != KEY_TRANSPARENT) return c;
+    }
+
+    char base = keyAt(index);
+    return _layers ? _layers->resolve(index, base) : base;
+}
+
+/**
+ * @brief Retrieves the character a held key was pressed with.
+ *
+ * Layer changes while a key is down do not change its character, so releases match presses.
+ *
+ * @param index The key index `row * numCols + col`.
+ * @return char The character recorded at press time, or the currently resolved character.
+ */
+char CustomKeypad::heldKey(KeypadKeyIndex index)
+{
+    for (byte s = 0; s < _activeCount; s++) {
+        if (_active[s].index == index) return _active[s].key;
+    }
+    return resolveKey(index);
+}
+
+/**
+ * @brief Passes a key event through the modifiers, layer stack and chord matcher.
+ *
+ * Modifier keys are consumed by the modifier table, layer-switch keys by the layer stack, and
+ * chord keys may be held back or suppressed by the chord matcher; everything else is delivered.
+ *
+ * @param event The press or release event.
+ * @return None
+ */
+void CustomKeypad::route(const KeyEvent &event)
+{
+    if (_modifiers && _modifiers->handle(event)) return;
+    if (_layers && _layers->handle(event)) return;
 
-    for (byte c = 0; c < _numCols; c++) {
-        digitalWrite(_cols[c], HIGH);
-        delayMicroseconds(10);
+    if (_chords) _chords->filter(event);
+    else deliver(event);
+}
 
-        for (byte r = 0; r < _numRows; r++) {
-            if (digitalRead(_rows[r]) == HIGH) {
-                if (count < maxKeys) {
-                    keysBuffer[count++] = _keymap[r][c];
-                }
+/**
+ * @brief Queues an event that passed the chord matcher and tracks held keys.
+ *
+ * A press adds the key to the active list used for hold and repeat timing, a release removes it.
+ * Keys pressed while KEYPAD_MAX_ACTIVE keys are already held are reported but not timed.
+ *
+ * @param event The event to deliver.
+ * @return None
+ * @note Updates the member variables `_reported`, `_active` and `_events`.
+ */
+void CustomKeypad::deliver(const KeyEvent &event)
+{
+    if (event.type == KEY_PRESSED) {
+        _reported.set(event.index);
+        if (_activeCount < KEYPAD_MAX_ACTIVE) {
+            ActiveKey &a = _active[_activeCount++];
+            a.index = event.index;
+            a.key = event.key;
+            a.pressedAt = event.time;
+            a.nextHold = 0;
+            a.holdDeadline = event.time + _holdAt[0];
+            a.interval = _repeatInterval;
+            a.nextRepeat = event.time + _repeatDelay;
+        }
+    }
+    else if (event.type == KEY_RELEASED) {
+        _reported.reset(event.index);
+        for (byte s = 0; s < _activeCount; s++) {
+            if (_active[s].index == event.index) {
+                _activeCount--;
+                for (; s < _activeCount; s++) _active[s] = _active[s + 1];
+                break;
             }
         }
-
-        digitalWrite(_cols[c], LOW);
     }
 
-    return count;
+    _events.push(event);
+}
+
+/**
+ * @brief Generates hold and typematic repeat events for held keys.
+ *
+ * Every held key walks the hold schedule: KEY_HOLD after `_holdTime` and KEY_HOLD_TIER(n) for
+ * each configured tier, in time order. Each key keeps the absolute deadline of its next hold
+ * event, so while nothing is due the check is a single comparison. With repeat enabled,
+ * KEY_REPEAT events follow from absolute deadlines: the first at press time + delay, each next
+ * one an interval after the previous deadline rather than after the call that emitted it, so
+ * irregular polling does not stretch the rate. If polling falls more than one interval behind,
+ * the missed repeats are skipped instead of being delivered as a burst. Hold and repeat events
+ * that fall due in the same call are queued in deadline order.
+ *
+ * @param now Current time in milliseconds.
+ * @return None
+ * @note Relies on member variables `_active`, `_holdAt`, `_holdType`, `_repeatDelay`,
+ *       `_repeatInterval`, `_repeatMinInterval` and `_repeatStep`.
+ */
+void CustomKeypad::updateHeld(unsigned long now)
+{
+    for (byte s = 0; s < _activeCount; s++) {
+        ActiveKey &a = _active[s];
+
+        for (;;) {
+            bool holdDue = a.nextHold < _holdCount && (long)(now - a.holdDeadline) >= 0;
+            bool repeatDue = _repeatInterval && (long)(now - a.nextRepeat) >= 0;
+            if (!holdDue && !repeatDue) break;
+
+            if (holdDue && (!repeatDue || (long)(a.holdDeadline - a.nextRepeat) <= 0)) {
+                KeyEvent ev = { _holdType[a.nextHold], a.index, a.key, a.holdDeadline };
+                _events.push(ev);
+                if (++a.nextHold < _holdCount) a.holdDeadline = a.pressedAt + _holdAt[a.nextHold];
+                continue;
+            }
+
+            KeyEvent ev = { KEY_REPEAT, a.index, a.key, a.nextRepeat };
+            _events.push(ev);
+
+            if (a.interval > _repeatMinInterval + _repeatStep) a.interval -= _repeatStep;
+            else if (_repeatMinInterval) a.interval = _repeatMinInterval;
+
+            a.nextRepeat += a.interval;
+            while ((long)(now - a.nextRepeat) >= 0) a.nextRepeat += a.interval;
+        }
+    }
 }
 
 /**
@@ -196,6 +702,93 @@ void CustomKeypad::setDebounceTime(unsigned int debounceTime)
 void CustomKeypad::setHoldTime(unsigned int holdTime)
 {
     _holdTime = holdTime;
+    buildHoldSchedule();
+}
+
+/**
+ * @brief Sets additional long-press tiers.
+ *
+ * A key held for `tiers[n]` milliseconds emits a KEY_HOLD_TIER(n) event, in addition to the
+ * KEY_HOLD event at the hold time. Tiers are sorted here, so `n` refers to the sorted position.
+ *
+ * @param tiers Hold durations in milliseconds, e.g. {500, 2000, 5000}.
+ * @param count Number of tiers, at most KEYPAD_MAX_HOLD_TIERS; 0 removes all tiers.
+ * @return None
+ * @note Updates the member variables `_tiers` and `_tierCount`. Keys already held keep their
+ *       current schedule position.
+ */
+void CustomKeypad::setHoldTiers(const unsigned int *tiers, byte count)
+{
+    _tierCount = 0;
+    for (byte i = 0; i < count && i < KEYPAD_MAX_HOLD_TIERS; i++) {
+        byte j = _tierCount++;
+        for (; j > 0 && _tiers[j - 1] > tiers[i]; j--) _tiers[j] = _tiers[j - 1];
+        _tiers[j] = tiers[i];
+    }
+    buildHoldSchedule();
+}
+
+/**
+ * @brief Merges the hold time and the hold tiers into one time-ordered schedule.
+ *
+ * Done once per configuration change so that held keys only compare against their next deadline.
+ *
+ * @param None
+ * @return None
+ * @note Updates the member variables `_holdAt`, `_holdType` and `_holdCount`.
+ */
+void CustomKeypad::buildHoldSchedule()
+{
+    byte t = 0;
+    bool holdPlaced = false;
+    _holdCount = 0;
+
+    while (t < _tierCount || !holdPlaced) {
+        if (!holdPlaced && (t == _tierCount || _holdTime <= _tiers[t])) {
+            _holdAt[_holdCount] = _holdTime;
+            _holdType[_holdCount++] = KEY_HOLD;
+            holdPlaced = true;
+        } else {
+            _holdAt[_holdCount] = _tiers[t];
+            _holdType[_holdCount++] = KEY_HOLD_TIER(t);
+            t++;
+        }
+    }
+}
+
+/**
+ * @brief Enables typematic repeat for held keys.
+ *
+ * A held key emits KEY_REPEAT events, the first `delay` after the press and then one every
+ * `interval`, scheduled from absolute deadlines so they do not drift with the polling rate.
+ *
+ * @param delay Initial delay in milliseconds.
+ * @param interval Repeat interval in milliseconds, 0 disables repeat.
+ * @return None
+ * @note Updates the member variables `_repeatDelay` and `_repeatInterval`.
+ */
+void CustomKeypad::setRepeat(unsigned int delay, unsigned int interval)
+{
+    _repeatDelay = delay;
+    _repeatInterval = interval;
+    if (_repeatMinInterval > interval) _repeatMinInterval = interval;
+}
+
+/**
+ * @brief Configures repeat acceleration.
+ *
+ * After each repeat the interval of that key shrinks by `step` until it reaches `minInterval`.
+ * Releasing the key restores the interval set with `setRepeat()`.
+ *
+ * @param minInterval Fastest repeat interval in milliseconds.
+ * @param step Interval reduction per repeat in milliseconds, 0 for a constant rate.
+ * @return None
+ * @note Updates the member variables `_repeatMinInterval` and `_repeatStep`.
+ */
+void CustomKeypad::setRepeatAcceleration(unsigned int minInterval, unsigned int step)
+{
+    _repeatMinInterval = minInterval;
+    _repeatStep = step;
 }
 
 /**
@@ -229,13 +822,301 @@ char CustomKeypad::getKeyState()
 /**
  * @brief Checks if a specific key is currently pressed.
  *
- * Compares the provided key with the last detected key to determine if it is pressed.
+ * Looks the key up in the base keymap and tests it against the keys `getKeys()` reports, so any
+ * of several simultaneously pressed keys is found. As with events, priority keys are included,
+ * while modifier keys, layer keys and chord keys held back or consumed by a chord are not.
  *
- * @param key The key to check.
+ * @param key The key to check, as it appears in the base keymap.
  * @return bool True if the specified key is pressed, false otherwise.
- * @note Relies on the member variable `_lastKey`.
+ * @note Relies on `reportedKeys()`.
  */
 bool CustomKeypad::isPressed(char key)
 {
-    return (_lastKey == key);
-}
\ No newline at end of file
+    int index = findKey(key);
+    return (index >= 0 && reportedKeys().test(index));
+}
+
+/**
+ * @brief Attaches a chord table to the keypad.
+ *
+ * Key events are routed through the chord matcher, which reports KEY_CHORD events and suppresses
+ * the individual events of the keys that formed the chord.
+ *
+ * @param chords The chord table, or nullptr to detach.
+ * @return None
+ * @note Updates the member variable `_chords`.
+ */
+void CustomKeypad::setChords(KeypadChords *chords)
+{
+    _chords = chords;
+}
+
+/**
+ * @brief Attaches a layer stack to the keypad.
+ *
+ * Key characters are then resolved through the active layers at press time, and KEY_MO(n) /
+ * KEY_TG(n) keys switch layers instead of producing events.
+ *
+ * @param layers The layer stack, or nullptr to detach.
+ * @return None
+ * @note Updates the member variable `_layers`.
+ */
+void CustomKeypad::setLayers(KeypadLayers *layers)
+{
+    _layers = layers;
+}
+
+/**
+ * @brief Attaches a modifier table to the keypad.
+ *
+ * Modifier keys then produce no events of their own, and while one is held the other keys are
+ * resolved through its keymap at press time, so `getKey()`, the listener and `readEvent()` all
+ * see the modified character. Modifiers take precedence over layers.
+ *
+ * @param modifiers The modifier table, or nullptr to detach.
+ * @return None
+ * @note Updates the member variable `_modifiers`.
+ */
+void CustomKeypad::setModifiers(KeypadModifiers *modifiers)
+{
+    _modifiers = modifiers;
+}
+
+/**
+ * @brief Chooses which side of the matrix is strobed.
+ *
+ * Every strobe step costs a settle delay, so a 4x8 keypad scans in 4 steps instead of 8 when its
+ * rows are strobed. The keymap, key indices and events are unchanged. Takes effect at `begin()`;
+ * drivers that cannot swap their lines keep strobing columns. With direct pins, the lines that are
+ * read need the pull resistors, so only internal pull-ups (`KeypadPullupDriver`) strobe rows; the
+ * external pull-down wiring of the pin constructor keeps strobing columns.
+ *
+ * @param orientation KEYPAD_STROBE_COLUMNS, KEYPAD_STROBE_ROWS or KEYPAD_STROBE_AUTO.
+ * @return None
+ * @note Updates the member variable `_orientation`.
+ */
+void CustomKeypad::setOrientation(byte orientation)
+{
+    _orientation = orientation;
+}
+
+/**
+ * @brief Sets the wait after selecting a column before the rows are read.
+ *
+ * @param us Settle time in microseconds.
+ * @return None
+ * @note Forwards to `KeypadDriver::setSettleTime()`.
+ */
+void CustomKeypad::setSettleTime(unsigned int us)
+{
+    _driver->setSettleTime(us);
+}
+
+/**
+ * @brief Overrides the settle time of one strobed column.
+ *
+ * @param col Column number (a row number when rows are strobed, see `setOrientation()`).
+ * @param us Settle time in microseconds.
+ * @return None
+ * @note Forwards to `KeypadDriver::setSettleTime()`.
+ */
+void CustomKeypad::setSettleTime(byte col, unsigned int us)
+{
+    _driver->setSettleTime(col, us);
+}
+
+/**
+ * @brief Measures how quickly the lines of this board settle and scans with that delay.
+ *
+ * Short traces settle in a fraction of the default wait, which shortens every scan; long cables
+ * get the longer wait they need. Call after `begin()` with no key pressed, then apply any
+ * per-column overrides. The result can be stored and restored with `setSettleTime()`.
+ *
+ * @param None
+ * @return unsigned int The settle time set in microseconds, or 0 if the driver cannot measure.
+ * @note Forwards to `KeypadDriver::calibrateSettle()`.
+ */
+unsigned int CustomKeypad::calibrateSettle()
+{
+    return _driver->calibrateSettle();
+}
+
+/**
+ * @brief Restricts scanning and events to a subset of keys.
+ *
+ * Disabled keys are masked out of the scan itself, so they never produce events, and columns left
+ * without enabled keys are not strobed, which shortens the scan. A disabled key that is held down
+ * is reported as released. Enabling every key restores the full scan.
+ *
+ * @param keys Bitmap of enabled key indices `row * numCols + col`.
+ * @return None
+ * @note Updates the member variables `_disabled` and `_scanMask`.
+ */
+void CustomKeypad::setEnabledKeys(const KeypadBitmap &keys)
+{
+    _disabled.clear();
+    for (unsigned int i = 0; i < keyCount(); i++) {
+        if (!keys.test(i)) _disabled.set(i);
+    }
+    buildScanMask();
+}
+
+/**
+ * @brief Restricts scanning and events to the keys with the given characters.
+ *
+ * For example `setEnabledKeys("0123456789#")` during PIN entry. Characters are looked up in the
+ * base keymap.
+ *
+ * @param keys NUL-terminated characters of the enabled keys, or nullptr to enable every key.
+ * @return bool True if every character was found in the keymap.
+ */
+bool CustomKeypad::setEnabledKeys(const char *keys)
+{
+    KeypadBitmap mask;
+    bool found = true;
+
+    if (!keys) {
+        for (unsigned int i = 0; i < keyCount(); i++) mask.set(i);
+    }
+    for (; keys && *keys; keys++) {
+        int index = findKey(*keys);
+        if (index >= 0) mask.set(index);
+        else found = false;
+    }
+    setEnabledKeys(mask);
+    return found;
+}
+
+/**
+ * @brief Designates a key as a priority key, e.g. an emergency stop.
+ *
+ * A priority key is taken out of the full scan and checked by `pollPriority()` with a single
+ * column select and row read, so its latency no longer depends on the matrix size. Its press and
+ * release are debounced like any key and returned by `readEvent()` ahead of all other events.
+ * Priority keys bypass layers, chords and holds, are reported by `getKeys()` and `isPressed()`
+ * but not `getKey()`, and are not supported on keypads in a KeypadGroup.
+ *
+ * @param key Character of the key in the base keymap.
+ * @return bool True if added, false if the key is unknown, KEYPAD_MAX_PRIORITY is reached or the
+ *         keypad is in a KeypadGroup.
+ * @note Updates the member variables `_priority` and `_priorityKeys`.
+ */
+bool CustomKeypad::addPriorityKey(char key)
+{
+    int index = findKey(key);
+    if (_group || index < 0 || _priorityCount >= KEYPAD_MAX_PRIORITY) return false;
+
+    PriorityKey &p = _priority[_priorityCount++];
+    p.index = index;
+    p.down = false;
+    p.changedAt = 0;
+    _priorityKeys.set(index);
+    buildScanMask();
+    return true;
+}
+
+/**
+ * @brief Checks the priority keys with one drive-and-read each.
+ *
+ * Called by `update()`, and meant to be called as often as possible in between, e.g. from a
+ * timer tick. The driver's `beginScan()` runs first, so drivers that sample all keys at once,
+ * such as KeypadAnalog, read fresh values. When called from an interrupt, it returns at once if
+ * the interrupted code is in the middle of a scan or poll, since the lines are in use.
+ *
+ * @param None
+ * @return None
+ * @note Uses Arduino `millis` and `micros` functions. Calling it from an interrupt is only safe
+ *       with direct pins: expander drivers use I2C, which needs interrupts enabled.
+ */
+void CustomKeypad::pollPriority()
+{
+    if (_scanning || _group || !_priorityCount) return;
+    _scanning = true;
+
+    _driver->beginScan();
+
+    for (byte i = 0; i < _priorityCount; i++) {
+        PriorityKey &p = _priority[i];
+
+        _driver->select(p.strobe);
+        _driver->waitSettled(p.strobe, micros());
+        bool down = (_driver->read() & p.line) != 0;
+        _driver->deselect(p.strobe);
+
+        unsigned long now = millis();
+        if (down != p.down && now - p.changedAt > _debounceTime) {
+            p.down = down;
+            p.changedAt = now;
+            KeyEvent ev = { (byte)(down ? KEY_PRESSED : KEY_RELEASED), p.index, keyAt(p.index), now };
+            _priorityEvents.push(ev);
+        }
+    }
+    _scanning = false;
+}
+
+/**
+ * @brief Scans lines with held or recently active keys more often than the rest.
+ *
+ * Between full sweeps, a pass only strobes hot lines: those that read a pressed key within the
+ * last `hotPasses` passes. Every `sweepEvery`-th pass is a full sweep, so a key anywhere in the
+ * matrix is seen within `sweepEvery` passes. KeypadScheduler honours this per keypad; keypads in
+ * a KeypadGroup share one column schedule and always scan every line.
+ *
+ * @param sweepEvery Passes per full sweep; 0 or 1 scans every line on every pass (the default).
+ * @param hotPasses Passes a line stays hot after its last pressed key.
+ * @return bool True if applied, false if the keypad is in a KeypadGroup.
+ * @note Updates the member variables `_sweepEvery` and `_hotPasses`.
+ */
+bool CustomKeypad::setHotScan(byte sweepEvery, byte hotPasses)
+{
+    if (_group) return false;
+
+    _sweepEvery = (sweepEvery > 1) ? sweepEvery : 0;
+    _hotPasses = hotPasses;
+    _pass = _sweepEvery ? _sweepEvery - 1 : 0;  // start with a full sweep
+    return true;
+}
+
+/**
+ * @brief Chooses which key `getKey()` and the listener report when several keys are down.
+ *
+ * KEYPAD_SCAN_ORDER reports the first key in scan order (first column, then first row), as
+ * before. KEYPAD_FIRST_PRESSED keeps reporting the key pressed first until it is released.
+ * KEYPAD_LAST_PRESSED reports the newest key, so rolling from one key to the next is never lost;
+ * releasing it falls back to the key pressed before. The press order comes from the held-key
+ * slots, so the lookup is O(1).
+ *
+ * @param policy KEYPAD_SCAN_ORDER, KEYPAD_FIRST_PRESSED or KEYPAD_LAST_PRESSED.
+ * @return None
+ * @note Updates the member variable `_keyPolicy`.
+ */
+void CustomKeypad::setKeyPolicy(byte policy)
+{
+    _keyPolicy = policy;
+}
+
+/**
+ * @brief Returns the character of the key reported by `getKey()`.
+ *
+ * Press order is tracked for up to KEYPAD_MAX_ACTIVE keys; beyond that the scan order applies.
+ *
+ * @param None
+ * @return char The character the key was pressed with, or 0 if no key is down.
+ */
+char CustomKeypad::primaryKey()
+{
+    if (_activeCount && _keyPolicy == KEYPAD_LAST_PRESSED) return _active[_activeCount - 1].key;
+    if (_activeCount && _keyPolicy == KEYPAD_FIRST_PRESSED) return _active[0].key;
+
+    // scan order: first column, then first row
+    int first = -1;
+    unsigned int order = ~0u;
+    for (int i = _reported.first(); i >= 0; i = _reported.next(i)) {
+        unsigned int o = (unsigned int)(i % _numCols) * _numRows + i / _numCols;
+        if (o < order) {
+            order = o;
+            first = i;
+        }
+    }
+    return (first >= 0) ? heldKey(first) : 0;
+}
@@ -1,5 +1,14 @@
 #pragma once
 #include <Arduino.h>
+#include "KeypadBitmap.h"
+#include "KeypadEvents.h"
+#include "KeypadChords.h"
+#include "KeypadLayers.h"
+#include "KeypadModifiers.h"
+#include "KeypadDriver.h"
+#include "KeypadPinDriver.h"
+#include "KeypadGroup.h"
+#include "KeypadScheduler.h"
 
 
 /**
@@ -9,6 +18,47 @@
 #define KEY_PRESSED     1  ///< Key is currently pressed.
 #define KEY_HOLD        2  ///< Key is held down for a specified duration.
 
+#ifndef NO_KEY
+#define NO_KEY  '\0'  ///< Keymap entry of an unpopulated matrix position; never scanned.
+#endif
+
+/**
+ * @brief Additional event types reported through readEvent().
+ */
+#define KEY_CHORD       3  ///< A chord of simultaneous keys fired (see KeypadChords).
+#define KEY_REPEAT      4  ///< Typematic repeat of a held key (see setRepeat()).
+#define KEY_TAP         5  ///< Single tap resolved (see KeypadGestures).
+#define KEY_DOUBLE_TAP  6  ///< Double tap resolved.
+#define KEY_TRIPLE_TAP  7  ///< Triple tap resolved.
+#define KEY_TAP_HOLD    8  ///< Tap followed by a held press resolved.
+#define KEY_HOLD_TIER(n)  (0x10 + (n))  ///< Key held past hold tier n (see setHoldTiers()).
+
+/**
+ * @brief Scan orientations for setOrientation().
+ */
+#define KEYPAD_STROBE_COLUMNS  0  ///< Drive each column and read the rows (default).
+#define KEYPAD_STROBE_ROWS     1  ///< Drive each row and read the columns.
+#define KEYPAD_STROBE_AUTO     2  ///< Strobe whichever side has fewer lines.
+
+/**
+ * @brief Policies for the key reported by getKey() when several keys are down (setKeyPolicy()).
+ */
+#define KEYPAD_SCAN_ORDER      0  ///< First key in scan order, column by column (default).
+#define KEYPAD_FIRST_PRESSED   1  ///< Oldest held key.
+#define KEYPAD_LAST_PRESSED    2  ///< Newest held key.
+
+#ifndef KEYPAD_MAX_ACTIVE
+#define KEYPAD_MAX_ACTIVE  6  ///< Held keys timed simultaneously for hold and repeat events.
+#endif
+
+#ifndef KEYPAD_MAX_PRIORITY
+#define KEYPAD_MAX_PRIORITY  2  ///< Priority keys polled outside the full scan.
+#endif
+
+#ifndef KEYPAD_MAX_HOLD_TIERS
+#define KEYPAD_MAX_HOLD_TIERS  4  ///< Long-press tiers in addition to the hold time.
+#endif
+
 
 typedef char KeypadEvent;
 typedef void (*KeypadEventListener)(KeypadEvent);
@@ -16,34 +66,132 @@ typedef void (*KeypadEventListener)(KeypadEvent);
 class CustomKeypad {
     public:
         CustomKeypad(char **keymap, byte *rows, byte *cols, byte numRows, byte numCols);
+        CustomKeypad(char **keymap, KeypadDriver &driver, byte numRows, byte numCols);
 
-        void begin();
+        bool begin();
+        bool update();
         char getKey();
         byte getKeys(char *keysBuffer, byte maxKeys);
         char getKeyState();
         bool isPressed(char key);
+        bool readEvent(KeyEvent &event);
+        const KeypadBitmap &getKeyBitmap();
+        int findKey(char key);
+        char keyAt(KeypadKeyIndex index);
         void setDebounceTime(unsigned int debounceTime);
         void setHoldTime(unsigned int holdTime);
+        void setHoldTiers(const unsigned int *tiers, byte count);
+        void setRepeat(unsigned int delay, unsigned int interval);
+        void setRepeatAcceleration(unsigned int minInterval, unsigned int step);
         void addEventListener(KeypadEventListener listener);
+        void setChords(KeypadChords *chords);
+        void setLayers(KeypadLayers *layers);
+        void setModifiers(KeypadModifiers *modifiers);
+        void setOrientation(byte orientation);
+        bool setHotScan(byte sweepEvery, byte hotPasses = 8);
+        void setKeyPolicy(byte policy);
+        bool addPriorityKey(char key);
+        void pollPriority();
+        void setEnabledKeys(const KeypadBitmap &keys);
+        bool setEnabledKeys(const char *keys);
+        void setSettleTime(unsigned int us);
+        void setSettleTime(byte col, unsigned int us);
+        unsigned int calibrateSettle();
 
     private:
-        byte *_rows;
-        byte *_cols;
+        friend class KeypadChords;
+        friend class KeypadGroup;
+        friend class KeypadScheduler;
+
+        KeypadPinDriver _pins;
+        KeypadDriver *_driver;
         byte _numRows;
         byte _numCols;
         char **_keymap;
-        
+        byte _orientation = KEYPAD_STROBE_COLUMNS;
+        bool _transposed = false;
+
         unsigned int _debounceTime = 50;
         unsigned int _holdTime = 1000;
+        unsigned int _repeatDelay = 500;
+        unsigned int _repeatInterval = 0;
+        unsigned int _repeatMinInterval = 0;
+        unsigned int _repeatStep = 0;
+
+        unsigned int _tiers[KEYPAD_MAX_HOLD_TIERS];
+        byte _tierCount = 0;
+        unsigned int _holdAt[KEYPAD_MAX_HOLD_TIERS + 1] = { 1000 };  // hold schedule
+        byte _holdType[KEYPAD_MAX_HOLD_TIERS + 1] = { KEY_HOLD };
+        byte _holdCount = 1;
 
         unsigned long _lastChange = 0;
+        unsigned int _changedAt[KEYPAD_MAX_KEYS];  // last change of each key, low bits of millis()
         unsigned long _pressStart = 0;
         char _lastKey = 0;
         char _keyState = KEY_RELEASED;
         bool _holding = false;
 
+        KeypadLineMask _scanMask[KEYPAD_MAX_STROBES] = {};  // lines kept per strobe; 0 skips it
+        byte _heat[KEYPAD_MAX_STROBES] = {};  // passes a strobe stays hot
+        byte _sweepEvery = 0;
+        byte _hotPasses = 8;
+        byte _pass = 0;
+        KeypadBitmap _disabled;  // keys excluded by setEnabledKeys()
+        KeypadBitmap _state;     // debounced matrix
+        KeypadBitmap _locked;    // keys inside their debounce interval
+        KeypadBitmap _reported;  // keys whose press has been delivered
+        KeyEventQueue _events;
+
+        struct PriorityKey {
+            KeypadKeyIndex index;
+            byte strobe;
+            KeypadLineMask line;
+            bool down;
+            unsigned long changedAt;
+        };
+        PriorityKey _priority[KEYPAD_MAX_PRIORITY];
+        byte _priorityCount = 0;
+        KeypadBitmap _priorityKeys;      // excluded from the full scan
+        KeyEventQueue _priorityEvents;   // read ahead of _events
+        volatile bool _scanning = false;
+        KeypadChords *_chords = nullptr;
+        KeypadLayers *_layers = nullptr;
+        KeypadModifiers *_modifiers = nullptr;
+        KeypadGroup *_group = nullptr;
+
+        struct ActiveKey {
+            KeypadKeyIndex index;
+            char key;
+            byte nextHold;
+            unsigned int interval;
+            unsigned long pressedAt;
+            unsigned long holdDeadline;
+            unsigned long nextRepeat;
+        };
+        ActiveKey _active[KEYPAD_MAX_ACTIVE];  // held keys in press order
+        byte _activeCount = 0;
+        byte _keyPolicy = KEYPAD_SCAN_ORDER;
+
         KeypadEventListener _eventListener = nullptr;
 
-        char scanKeypad();
+        void scanMatrix(KeypadBitmap &raw);
+        unsigned int keyCount();
+        byte strobeCount();
+        bool beginPass(KeypadBitmap &raw);
+        bool scansStrobe(byte strobe, bool sweep);
+        byte nextStrobe(byte from, bool sweep);
+        void mergeStrobe(KeypadBitmap &raw, byte strobe, KeypadLineMask lines, bool sweep);
+        void clearLines(KeypadBitmap &raw, byte strobe);
+        void buildScanMask();
+        void mergeLines(KeypadBitmap &raw, byte strobe, KeypadLineMask lines);
+        bool process(const KeypadBitmap &raw, unsigned long now);
+        char resolveKey(KeypadKeyIndex index);
+        char heldKey(KeypadKeyIndex index);
+        KeypadBitmap reportedKeys();
+        char primaryKey();
+        void route(const KeyEvent &event);
+        void deliver(const KeyEvent &event);
+        void updateHeld(unsigned long now);
+        void buildHoldSchedule();
         void transitionTo(char newState);
-};
\ No newline at end of file
+};
@@ -0,0 +1,251 @@
+/**
+ * @file KeypadAnalog.cpp
+ * @brief Implementation of the KeypadAnalog driver for resistor-ladder keypads on one ADC pin.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadAnalog.h"
+
+/**
+ * @brief Constructs a driver for a resistor-ladder keypad.
+ *
+ * Each key pulls the ladder output to its own voltage. Key k is reported at row `k / numCols`,
+ * column `k % numCols` of the keymap, so a 4x4 ladder keypad uses the same keymap as a matrix.
+ * Levels must be provided with `setLevels()` or measured with `calibrate()` before use.
+ *
+ * @param pin Analog input pin of the ladder.
+ * @param numKeys Number of keys on the ladder, at most KEYPAD_ANALOG_MAX_KEYS.
+ * @return None
+ */
+KeypadAnalog::KeypadAnalog(byte pin, byte numKeys)
+{
+    _pin = pin;
+    _numKeys = (numKeys > KEYPAD_ANALOG_MAX_KEYS) ? KEYPAD_ANALOG_MAX_KEYS : numKeys;
+    memset(_levels, 0, sizeof(_levels));
+    rebuild();
+}
+
+/**
+ * @brief Configures the ADC pin.
+ *
+ * @param numRows Number of rows in the keymap.
+ * @param numCols Number of columns in the keymap.
+ * @return None
+ * @note Uses Arduino `pinMode` function.
+ */
+void KeypadAnalog::begin(byte numRows, byte numCols)
+{
+    _numCols = numCols;
+    (void)numRows;
+    pinMode(_pin, INPUT);
+}
+
+/**
+ * @brief Samples the ladder once per scan and classifies the key.
+ *
+ * A noisy window (samples spread wider than the tolerance, e.g. while a key is bouncing or the
+ * ladder is still charging) keeps the previous key, so only stable readings change the result.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadAnalog::beginScan()
+{
+    uint16_t value;
+    if (measure(value)) _key = classify(value);
+}
+
+/**
+ * @brief Selects a keymap column; the ladder has no hardware to switch.
+ *
+ * @param col Column number.
+ * @return None
+ */
+void KeypadAnalog::select(byte col)
+{
+    _col = col;
+}
+
+/**
+ * @brief Reports the classified key if it belongs to the selected column.
+ *
+ * @param None
+ * @return KeypadLineMask Bit r set if the pressed key is at row r of the selected column.
+ */
+KeypadLineMask KeypadAnalog::read()
+{
+    if (_key == KEYPAD_ANALOG_NONE || _key % _numCols != _col) return 0;
+    return (KeypadLineMask)1 << (_key / _numCols);
+}
+
+/**
+ * @brief Nothing to release on a resistor ladder.
+ *
+ * @param col Column number.
+ * @return None
+ */
+void KeypadAnalog::deselect(byte col)
+{
+    (void)col;
+}
+
+/**
+ * @brief Loads stored ADC levels, e.g. from EEPROM or computed from the ladder resistors.
+ *
+ * @param levels ADC reading of each key, in key index order (numKeys entries).
+ * @param idle ADC reading with no key pressed.
+ * @return None
+ */
+void KeypadAnalog::setLevels(const uint16_t *levels, uint16_t idle)
+{
+    memcpy(_levels, levels, sizeof(uint16_t) * _numKeys);
+    _idle = idle;
+    rebuild();
+}
+
+/**
+ * @brief Copies the current ADC levels, e.g. to store a calibration.
+ *
+ * @param levels Buffer of numKeys entries receiving the level of each key.
+ * @return None
+ */
+void KeypadAnalog::getLevels(uint16_t *levels)
+{
+    memcpy(levels, _levels, sizeof(uint16_t) * _numKeys);
+}
+
+/**
+ * @brief Sets the oversampling window.
+ *
+ * The median of the window is classified, which rejects single-sample spikes.
+ *
+ * @param samples Samples per scan, odd, 1 to KEYPAD_ANALOG_MAX_SAMPLES.
+ * @return None
+ * @note Updates the member variable `_samples`.
+ */
+void KeypadAnalog::setSamples(byte samples)
+{
+    if (samples < 1) samples = 1;
+    if (samples > KEYPAD_ANALOG_MAX_SAMPLES) samples = KEYPAD_ANALOG_MAX_SAMPLES;
+    _samples = samples | 1;
+}
+
+/**
+ * @brief Sets the largest spread within a sample window that still counts as stable.
+ *
+ * @param tolerance Spread in ADC counts.
+ * @return None
+ * @note Updates the member variable `_tolerance`.
+ */
+void KeypadAnalog::setTolerance(uint16_t tolerance)
+{
+    _tolerance = tolerance;
+}
+
+/**
+ * @brief Measures the level of a key while it is held down.
+ *
+ * @param key Key index `row * numCols + col`.
+ * @return bool True if a stable reading was stored.
+ */
+bool KeypadAnalog::calibrate(byte key)
+{
+    uint16_t value;
+    if (key >= _numKeys || !measure(value)) return false;
+
+    _levels[key] = value;
+    rebuild();
+    return true;
+}
+
+/**
+ * @brief Measures the level with no key pressed.
+ *
+ * @param None
+ * @return bool True if a stable reading was stored.
+ */
+bool KeypadAnalog::calibrateIdle()
+{
+    uint16_t value;
+    if (!measure(value)) return false;
+
+    _idle = value;
+    rebuild();
+    return true;
+}
+
+/**
+ * @brief Classifies an ADC reading with a binary search of the threshold table.
+ *
+ * @param value ADC reading.
+ * @return byte Key index, or KEYPAD_ANALOG_NONE for the idle level.
+ */
+byte KeypadAnalog::classify(uint16_t value)
+{
+    byte lo = 0;
+    byte hi = _count - 1;
+
+    while (lo < hi) {
+        byte mid = (lo + hi) / 2;
+        if (value <= _bounds[mid]) hi = mid;
+        else lo = mid + 1;
+    }
+    return _slots[lo];
+}
+
+/**
+ * @brief Takes an oversampled reading.
+ *
+ * @param median Receives the median of the window.
+ * @return bool True if the window spread is within the tolerance.
+ * @note Uses Arduino `analogRead` function.
+ */
+bool KeypadAnalog::measure(uint16_t &median)
+{
+    uint16_t window[KEYPAD_ANALOG_MAX_SAMPLES];
+
+    for (byte i = 0; i < _samples; i++) {
+        uint16_t v = analogRead(_pin);
+        byte j = i;
+        for (; j > 0 && window[j - 1] > v; j--) window[j] = window[j - 1];
+        window[j] = v;
+    }
+
+    median = window[_samples / 2];
+    return (window[_samples - 1] - window[0]) <= _tolerance;
+}
+
+/**
+ * @brief Rebuilds the sorted threshold table from the key and idle levels.
+ *
+ * Levels are sorted once, and the boundary between neighbours is their midpoint, so a scan is a
+ * binary search instead of a comparison against every key.
+ *
+ * @param None
+ * @return None
+ * @note Updates the member variables `_bounds`, `_slots` and `_count`.
+ */
+void KeypadAnalog::rebuild()
+{
+    uint16_t sorted[KEYPAD_ANALOG_MAX_KEYS + 1];
+    _count = 0;
+
+    for (byte k = 0; k <= _numKeys; k++) {
+        uint16_t level = (k < _numKeys) ? _levels[k] : _idle;
+        byte slot = (k < _numKeys) ? k : KEYPAD_ANALOG_NONE;
+
+        byte j = _count++;
+        for (; j > 0 && sorted[j - 1] > level; j--) {
+            sorted[j] = sorted[j - 1];
+            _slots[j] = _slots[j - 1];
+        }
+        sorted[j] = level;
+        _slots[j] = slot;
+    }
+
+    for (byte i = 0; i + 1 < _count; i++) {
+        _bounds[i] = sorted[i] + (sorted[i + 1] - sorted[i]) / 2;
+    }
+    _bounds[_count - 1] = 0xFFFF;
+}
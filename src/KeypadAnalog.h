@@ -0,0 +1,51 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadDriver.h"
+
+
+#ifndef KEYPAD_ANALOG_MAX_KEYS
+#define KEYPAD_ANALOG_MAX_KEYS  16  ///< Keys on one resistor ladder.
+#endif
+
+#define KEYPAD_ANALOG_MAX_SAMPLES  9  ///< Upper bound for setSamples().
+#define KEYPAD_ANALOG_NONE      0xFF  ///< Classification result when no key is pressed.
+
+class KeypadAnalog : public KeypadDriver {
+    public:
+        KeypadAnalog(byte pin, byte numKeys);
+
+        void begin(byte numRows, byte numCols) override;
+        void beginScan() override;
+        void select(byte col) override;
+        KeypadLineMask read() override;
+        void deselect(byte col) override;
+
+        void setLevels(const uint16_t *levels, uint16_t idle);
+        void getLevels(uint16_t *levels);
+        void setSamples(byte samples);
+        void setTolerance(uint16_t tolerance);
+        bool calibrate(byte key);
+        bool calibrateIdle();
+        byte classify(uint16_t value);
+
+    private:
+        byte _pin;
+        byte _numKeys;
+        byte _numCols = 1;
+        byte _samples = 5;
+        uint16_t _tolerance = 8;
+
+        uint16_t _levels[KEYPAD_ANALOG_MAX_KEYS];
+        uint16_t _idle = 0;
+
+        // sorted classification table: value <= _bounds[i] -> _slots[i]
+        uint16_t _bounds[KEYPAD_ANALOG_MAX_KEYS + 1];
+        byte _slots[KEYPAD_ANALOG_MAX_KEYS + 1];
+        byte _count = 0;
+
+        byte _key = KEYPAD_ANALOG_NONE;
+        byte _col = 0;
+
+        bool measure(uint16_t &median);
+        void rebuild();
+};
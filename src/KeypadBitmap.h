@@ -0,0 +1,148 @@
+#pragma once
+#include <Arduino.h>
+
+
+#ifndef KEYPAD_MAX_KEYS
+#define KEYPAD_MAX_KEYS     32  ///< Largest supported rows * cols, e.g. 256 for 16x16.
+#endif
+
+#ifndef KEYPAD_BITMAP_WORD
+#define KEYPAD_BITMAP_WORD  uint32_t  ///< Bitmap word; trades speed for size only.
+#endif
+
+#define KEYPAD_BITMAP_BITS   (sizeof(KEYPAD_BITMAP_WORD) * 8)  ///< Keys per bitmap word.
+#define KEYPAD_BITMAP_WORDS  ((KEYPAD_MAX_KEYS + KEYPAD_BITMAP_BITS - 1) / KEYPAD_BITMAP_BITS)  ///< Words per bitmap.
+
+template <bool Wide> struct KeypadIndexType { typedef uint8_t type; };
+template <> struct KeypadIndexType<true> { typedef uint16_t type; };
+
+/**
+ * @brief Key index `row * numCols + col`.
+ *
+ * One byte up to 255 keys, two bytes from 256, so KEYPAD_NO_INDEX never matches a real key.
+ */
+typedef KeypadIndexType<(KEYPAD_MAX_KEYS > 255)>::type KeypadKeyIndex;
+
+#define KEYPAD_NO_INDEX  ((KeypadKeyIndex)~0)  ///< Key index that matches no key.
+
+/**
+ * @brief One bit per key of the matrix, indexed by `row * numCols + col`.
+ *
+ * Holds the debounced key state and the masks compared against it (chords, enables). The bits
+ * are an array of KEYPAD_BITMAP_WORD words and every operation works a word at a time, so the
+ * default single-word bitmap still compiles to one AND/compare, and large matrices cost one
+ * operation per word. Iteration with `first()` / `next()` skips empty words and finds set bits
+ * with count-trailing-zeros.
+ */
+class KeypadBitmap {
+    public:
+        KeypadBitmap() { clear(); }
+
+        void clear()
+        {
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) _words[w] = 0;
+        }
+
+        void set(unsigned int index)        { _words[index / KEYPAD_BITMAP_BITS] |= wordMask(index); }
+        void reset(unsigned int index)      { _words[index / KEYPAD_BITMAP_BITS] &= ~wordMask(index); }
+        bool test(unsigned int index) const { return (_words[index / KEYPAD_BITMAP_BITS] & wordMask(index)) != 0; }
+
+        bool any() const
+        {
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) {
+                if (_words[w]) return true;
+            }
+            return false;
+        }
+
+        /** @brief Index of the lowest set bit, or -1 when empty. */
+        int first() const { return scan(0); }
+
+        /** @brief Index of the lowest set bit above `index`, or -1 when there is none. */
+        int next(int index) const
+        {
+            unsigned int w = index / KEYPAD_BITMAP_BITS;
+            unsigned int b = index % KEYPAD_BITMAP_BITS;
+            if (b + 1 < KEYPAD_BITMAP_BITS) {
+                KEYPAD_BITMAP_WORD rest = _words[w] & ~(((KEYPAD_BITMAP_WORD)2 << b) - 1);
+                if (rest) return w * KEYPAD_BITMAP_BITS + ctz(rest);
+            }
+            return scan(w + 1);
+        }
+
+        /** @brief True if every bit of `mask` is also set here. */
+        bool contains(const KeypadBitmap &mask) const
+        {
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) {
+                if ((_words[w] & mask._words[w]) != mask._words[w]) return false;
+            }
+            return true;
+        }
+
+        KeypadBitmap operator&(const KeypadBitmap &o) const
+        {
+            KeypadBitmap r(*this);
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) r._words[w] &= o._words[w];
+            return r;
+        }
+
+        KeypadBitmap operator|(const KeypadBitmap &o) const
+        {
+            KeypadBitmap r(*this);
+            return r |= o;
+        }
+
+        KeypadBitmap operator^(const KeypadBitmap &o) const
+        {
+            KeypadBitmap r(*this);
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) r._words[w] ^= o._words[w];
+            return r;
+        }
+
+        KeypadBitmap andNot(const KeypadBitmap &o) const
+        {
+            KeypadBitmap r(*this);
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) r._words[w] &= ~o._words[w];
+            return r;
+        }
+
+        KeypadBitmap &operator|=(const KeypadBitmap &o)
+        {
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) _words[w] |= o._words[w];
+            return *this;
+        }
+
+        bool operator==(const KeypadBitmap &o) const
+        {
+            for (byte w = 0; w < KEYPAD_BITMAP_WORDS; w++) {
+                if (_words[w] != o._words[w]) return false;
+            }
+            return true;
+        }
+
+        bool operator!=(const KeypadBitmap &o) const { return !(*this == o); }
+
+    private:
+        KEYPAD_BITMAP_WORD _words[KEYPAD_BITMAP_WORDS];
+
+        static KEYPAD_BITMAP_WORD wordMask(unsigned int index)
+        {
+            return (KEYPAD_BITMAP_WORD)1 << (index % KEYPAD_BITMAP_BITS);
+        }
+
+        static int ctz(KEYPAD_BITMAP_WORD word)
+        {
+            // Narrowest builtin that holds a word, so AVR avoids the 64-bit libgcc helper.
+            if (sizeof(KEYPAD_BITMAP_WORD) <= sizeof(unsigned int)) return __builtin_ctz(word);
+            if (sizeof(KEYPAD_BITMAP_WORD) <= sizeof(unsigned long)) return __builtin_ctzl(word);
+            return __builtin_ctzll(word);
+        }
+
+        int scan(unsigned int w) const
+        {
+            for (; w < KEYPAD_BITMAP_WORDS; w++) {
+                if (_words[w]) return w * KEYPAD_BITMAP_BITS + ctz(_words[w]);
+            }
+            return -1;
+        }
+};
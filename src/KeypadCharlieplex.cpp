@@ -0,0 +1,110 @@
+/**
+ * @file KeypadCharlieplex.cpp
+ * @brief Implementation of the KeypadCharlieplex driver for charlieplexed key matrices.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadCharlieplex.h"
+
+/**
+ * @brief Constructs a driver that scans up to N*(N-1) keys from N pins.
+ *
+ * Column c drives pin c LOW; its rows are the remaining pins in order, so row r of column c is
+ * pin r when r < c and pin r + 1 otherwise. The keymap is therefore (N - 1) rows by N columns.
+ * Each key connects its two pins through a diode (anode on the row pin), which keeps reverse
+ * paths from ghosting when several keys are held.
+ *
+ * The drive and sense pin of every step is resolved here, once, so a scan step is a table lookup.
+ *
+ * @param pins Array of the N matrix pins.
+ * @param numPins Number of pins, 2 to KEYPAD_CHARLIE_MAX_PINS.
+ * @return None
+ */
+KeypadCharlieplex::KeypadCharlieplex(const byte *pins, byte numPins)
+{
+    _numPins = (numPins > KEYPAD_CHARLIE_MAX_PINS) ? KEYPAD_CHARLIE_MAX_PINS : numPins;
+
+    for (byte c = 0; c < _numPins; c++) {
+        _drive[c] = pins[c];
+        for (byte r = 0; r + 1 < _numPins; r++) {
+            _sense[c][r] = pins[(r < c) ? r : r + 1];
+        }
+    }
+}
+
+/**
+ * @brief Releases every pin to an input with pull-up.
+ *
+ * No pin has a fixed role: each one is a column while it is driven and a row otherwise.
+ *
+ * @param numRows Number of rows in the keymap (numPins - 1).
+ * @param numCols Number of columns in the keymap (numPins).
+ * @return None
+ * @note Uses Arduino `pinMode` function.
+ */
+void KeypadCharlieplex::begin(byte numRows, byte numCols)
+{
+    (void)numRows;
+    (void)numCols;
+
+    for (byte c = 0; c < _numPins; c++) {
+        pinMode(_drive[c], INPUT_PULLUP);
+    }
+}
+
+/**
+ * @brief Drives the pin of a column LOW and leaves every other pin as a pulled-up input.
+ *
+ * @param col Column number.
+ * @return None
+ * @note Uses Arduino `pinMode` and `digitalWrite` functions.
+ */
+void KeypadCharlieplex::select(byte col)
+{
+    _col = col;
+    digitalWrite(_drive[col], LOW);
+    pinMode(_drive[col], OUTPUT);
+}
+
+/**
+ * @brief Returns the settle time of a column.
+ *
+ * @param col Column number.
+ * @return unsigned int KEYPAD_SETTLE_US.
+ */
+unsigned int KeypadCharlieplex::settleTime(byte col)
+{
+    (void)col;
+    return KEYPAD_SETTLE_US;
+}
+
+/**
+ * @brief Reads the sense pins of the selected column.
+ *
+ * @param None
+ * @return KeypadLineMask Bit r set for each row pulled LOW by the driven pin.
+ * @note Uses Arduino `digitalRead` function.
+ */
+KeypadLineMask KeypadCharlieplex::read()
+{
+    KeypadLineMask rows = 0;
+    const byte *sense = _sense[_col];
+
+    for (byte r = 0; r + 1 < _numPins; r++) {
+        if (digitalRead(sense[r]) == LOW) rows |= (KeypadLineMask)1 << r;
+    }
+    return rows;
+}
+
+/**
+ * @brief Returns the pin of a column to an input with pull-up, ready to sense again.
+ *
+ * @param col Column number.
+ * @return None
+ * @note Uses Arduino `pinMode` function.
+ */
+void KeypadCharlieplex::deselect(byte col)
+{
+    pinMode(_drive[col], INPUT_PULLUP);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadDriver.h"
+
+
+#ifndef KEYPAD_CHARLIE_MAX_PINS
+#define KEYPAD_CHARLIE_MAX_PINS  8  ///< Pins in one charlieplexed matrix (up to N*(N-1) keys).
+#endif
+
+class KeypadCharlieplex : public KeypadDriver {
+    public:
+        KeypadCharlieplex(const byte *pins, byte numPins);
+
+        void begin(byte numRows, byte numCols) override;
+        void select(byte col) override;
+        unsigned int settleTime(byte col) override;
+        KeypadLineMask read() override;
+        void deselect(byte col) override;
+
+    private:
+        byte _numPins;
+        byte _drive[KEYPAD_CHARLIE_MAX_PINS];                              // pin driven LOW for column c
+        byte _sense[KEYPAD_CHARLIE_MAX_PINS][KEYPAD_CHARLIE_MAX_PINS - 1];  // pin of row r in column c
+        byte _col = 0;
+};
@@ -0,0 +1,149 @@
+/**
+ * @file KeypadChords.cpp
+ * @brief Implementation of the KeypadChords class for detecting simultaneous key combinations.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadChords.h"
+#include "CustomKeypad.h"
+
+/**
+ * @brief Constructs an empty chord table for a keypad.
+ *
+ * The table only takes effect once attached with `CustomKeypad::setChords()`.
+ *
+ * @param keypad The keypad whose keymap resolves chord keys.
+ * @return None
+ */
+KeypadChords::KeypadChords(CustomKeypad &keypad) : _keypad(keypad)
+{
+}
+
+/**
+ * @brief Defines a chord.
+ *
+ * The key characters are resolved against the keymap once, here, into a bitmask. Matching then
+ * costs one compare per chord whenever the debounced key state changes.
+ *
+ * @param keys NUL-terminated characters of the keys that form the chord (two to
+ *             KEYPAD_MAX_CHORD_KEYS).
+ * @param code Character reported in the KEY_CHORD event when the chord fires.
+ * @return bool True if the chord was added, false if the table is full, a key is unknown or the
+ *         chord has too few or too many keys.
+ */
+bool KeypadChords::addChord(const char *keys, char code)
+{
+    if (_count >= KEYPAD_MAX_CHORDS) return false;
+
+    KeypadBitmap mask;
+    byte size = 0;
+    for (; *keys; keys++, size++) {
+        int index = _keypad.findKey(*keys);
+        if (index < 0) return false;
+        mask.set(index);
+    }
+    if (size < 2 || size > KEYPAD_MAX_CHORD_KEYS) return false;
+
+    _masks[_count] = mask;
+    _codes[_count] = code;
+    _count++;
+    _members |= mask;
+    return true;
+}
+
+/**
+ * @brief Sets the chord window.
+ *
+ * All keys of a chord must go down within this interval of the first one. Presses of chord keys
+ * are held back for at most this long before being reported individually.
+ *
+ * @param window The chord window in milliseconds.
+ * @return None
+ * @note Updates the member variable `_window`.
+ */
+void KeypadChords::setChordWindow(unsigned int window)
+{
+    _window = window;
+}
+
+/**
+ * @brief Routes a debounced key event through the chord matcher.
+ *
+ * Presses of keys that belong to a chord are held back while they may still complete one. When
+ * the held-back set equals a chord mask, a single KEY_CHORD event is delivered and the individual
+ * presses and their releases are suppressed. When the set can no longer become a chord, the
+ * held-back presses are delivered in press order, with the key and time they had when pressed,
+ * ahead of the current event. Held-back presses whose window had already expired at the time of
+ * the event are delivered first, so a late `update()` never completes an expired chord.
+ *
+ * @param ev The key event produced by the keypad scan.
+ * @return None
+ * @note Relies on member variables `_members`, `_pending`, `_held`, `_fired` and `_masks`.
+ */
+void KeypadChords::filter(const KeyEvent &ev)
+{
+    poll(ev.time);
+
+    if (ev.type == KEY_PRESSED && _members.test(ev.index)) {
+        _pending.set(ev.index);
+        _held[_heldCount++] = ev;
+
+        bool partial = false;
+        for (byte i = 0; i < _count; i++) {
+            if (_pending == _masks[i]) {
+                KeyEvent chord = { KEY_CHORD, i, _codes[i], ev.time };
+                _fired |= _pending;
+                _pending.clear();
+                _heldCount = 0;
+                _keypad.deliver(chord);
+                return;
+            }
+            if (_masks[i].contains(_pending)) partial = true;
+        }
+        if (!partial) flush();
+        return;
+    }
+
+    if (ev.type == KEY_RELEASED && _fired.test(ev.index)) {
+        _fired.reset(ev.index);
+        return;
+    }
+
+    // another key or a held-back key going up breaks the chord in progress
+    if (ev.type == KEY_PRESSED || (ev.type == KEY_RELEASED && _pending.test(ev.index))) {
+        flush();
+    }
+    _keypad.deliver(ev);
+}
+
+/**
+ * @brief Releases held-back presses once the chord window has expired.
+ *
+ * @param now Current time in milliseconds.
+ * @return None
+ */
+void KeypadChords::poll(unsigned long now)
+{
+    if (_heldCount && (now - _held[0].time) >= _window) {
+        flush();
+    }
+}
+
+/**
+ * @brief Delivers every held-back press as an individual KEY_PRESSED event.
+ *
+ * The presses are replayed as recorded, so a layer change since a key went down does not alter
+ * the character it reports.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadChords::flush()
+{
+    byte count = _heldCount;
+    _pending.clear();
+    _heldCount = 0;
+
+    for (byte i = 0; i < count; i++) _keypad.deliver(_held[i]);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadBitmap.h"
+#include "KeypadEvents.h"
+
+
+#ifndef KEYPAD_MAX_CHORDS
+#define KEYPAD_MAX_CHORDS  8  ///< Chord definitions per KeypadChords object.
+#endif
+
+#ifndef KEYPAD_MAX_CHORD_KEYS
+#define KEYPAD_MAX_CHORD_KEYS  4  ///< Keys per chord.
+#endif
+
+class CustomKeypad;
+
+class KeypadChords {
+    public:
+        KeypadChords(CustomKeypad &keypad);
+
+        bool addChord(const char *keys, char code);
+        void setChordWindow(unsigned int window);
+
+    private:
+        friend class CustomKeypad;
+
+        CustomKeypad &_keypad;
+        KeypadBitmap _masks[KEYPAD_MAX_CHORDS];
+        char _codes[KEYPAD_MAX_CHORDS];
+        byte _count = 0;
+
+        KeypadBitmap _members;
+        KeypadBitmap _pending;
+        KeypadBitmap _fired;
+        KeyEvent _held[KEYPAD_MAX_CHORD_KEYS + 1];  // held-back presses in press order
+        byte _heldCount = 0;
+        unsigned int _window = 50;
+
+        void filter(const KeyEvent &ev);
+        void poll(unsigned long now);
+        void flush();
+};
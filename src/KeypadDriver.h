@@ -0,0 +1,82 @@
+#pragma once
+#include <Arduino.h>
+
+
+#ifndef KEYPAD_LINE_WORD
+#define KEYPAD_LINE_WORD  uint16_t  ///< One bit per row read in a single column step.
+#endif
+
+#ifndef KEYPAD_SETTLE_US
+#define KEYPAD_SETTLE_US  10  ///< Default settle wait after selecting a column, in microseconds.
+#endif
+
+#ifndef KEYPAD_MAX_STROBES
+#define KEYPAD_MAX_STROBES  16  ///< Strobed lines (columns) per matrix.
+#endif
+
+typedef KEYPAD_LINE_WORD KeypadLineMask;
+
+#define KEYPAD_MAX_LINES  (sizeof(KeypadLineMask) * 8)  ///< Sensed lines (rows) per strobe.
+
+/**
+ * @brief Hardware access used by CustomKeypad to scan the matrix.
+ *
+ * A scan selects each column in turn, reads all rows at once and deselects the column again.
+ * Implementations only move bits; debouncing, events and keymaps stay in CustomKeypad, so every
+ * backend gets the same behaviour.
+ */
+class KeypadDriver {
+    public:
+        /** @brief Configures the hardware for a matrix of the given size. */
+        virtual void begin(byte numRows, byte numCols) = 0;
+
+        /** @brief Called once before the columns of a scan; for drivers that sample all keys at once. */
+        virtual void beginScan() {}
+
+        /**
+         * @brief Activates a column. The rows are valid once settleTime(col) has passed; drivers
+         *        that report 0 wait inside select() themselves.
+         */
+        virtual void select(byte col) = 0;
+
+        /** @brief Microseconds the rows need after select(col) before read(). */
+        virtual unsigned int settleTime(byte col) { (void)col; return 0; }
+
+        /** @brief Reads every row of the selected column; bit r is set when row r is pressed. */
+        virtual KeypadLineMask read() = 0;
+
+        /** @brief Returns a column to its idle state. */
+        virtual void deselect(byte col) = 0;
+
+        /**
+         * @brief Swaps the strobed and sensed lines, so select() drives a row and read() returns
+         *        the columns. Called before begin(); returns false if the hardware cannot swap.
+         */
+        virtual bool setTransposed(bool transposed) { return !transposed; }
+
+        /** @brief Sets the settle wait after every select(), in microseconds. */
+        virtual void setSettleTime(unsigned int us) { (void)us; }
+
+        /** @brief Overrides the settle wait after selecting one column. */
+        virtual void setSettleTime(byte col, unsigned int us) { (void)col; (void)us; }
+
+        /**
+         * @brief Measures how long the sensed lines take to return to idle and uses that as the
+         *        settle time. Called after begin() with no key pressed; returns the time set, or
+         *        0 if the driver cannot measure.
+         */
+        virtual unsigned int calibrateSettle() { return 0; }
+
+        /**
+         * @brief Waits out whatever is left of the settle time of a column selected at `selectedAt`
+         *        (micros()), so work done in between is not added on top of the settle time.
+         */
+        void waitSettled(byte col, unsigned long selectedAt)
+        {
+            unsigned int settle = settleTime(col);
+            if (!settle) return;
+
+            unsigned long spent = micros() - selectedAt;
+            if (spent < settle) delayMicroseconds(settle - spent);
+        }
+};
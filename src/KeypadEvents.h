@@ -0,0 +1,55 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadBitmap.h"
+
+
+#ifndef KEYPAD_EVENT_QUEUE_SIZE
+#define KEYPAD_EVENT_QUEUE_SIZE  8  ///< Events buffered between two readEvent() calls.
+#endif
+
+/**
+ * @brief A timestamped keypad event.
+ *
+ * `type` uses the key state constants of CustomKeypad.h (KEY_PRESSED, KEY_RELEASED, KEY_HOLD)
+ * plus the event-only types defined there (e.g. KEY_CHORD).
+ */
+struct KeyEvent {
+    byte type;            ///< Event type.
+    KeypadKeyIndex index; ///< Key index (`row * numCols + col`), or chord number for KEY_CHORD.
+    char key;             ///< Key character from the keymap, or the chord code for KEY_CHORD.
+    unsigned long time;   ///< `millis()` timestamp of the change.
+};
+
+/**
+ * @brief Fixed-size FIFO of key events.
+ *
+ * Events are dropped, not overwritten, when the queue is full so that a release is never
+ * reported without its press.
+ */
+class KeyEventQueue {
+    public:
+        bool push(const KeyEvent &ev)
+        {
+            if (_count >= KEYPAD_EVENT_QUEUE_SIZE) return false;
+            _events[(_head + _count) % KEYPAD_EVENT_QUEUE_SIZE] = ev;
+            _count++;
+            return true;
+        }
+
+        bool pop(KeyEvent &ev)
+        {
+            if (!_count) return false;
+            ev = _events[_head];
+            _head = (_head + 1) % KEYPAD_EVENT_QUEUE_SIZE;
+            _count--;
+            return true;
+        }
+
+        byte available() const { return _count; }
+        void clear()           { _head = 0; _count = 0; }
+
+    private:
+        KeyEvent _events[KEYPAD_EVENT_QUEUE_SIZE];
+        byte _head = 0;
+        byte _count = 0;
+};
@@ -0,0 +1,125 @@
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+#include "KeypadDriver.h"
+
+
+/**
+ * @brief MCP23017 register addresses (IOCON.BANK = 0).
+ */
+#define MCP23017_IODIRA  0x00
+#define MCP23017_IODIRB  0x01
+#define MCP23017_GPPUB   0x0D
+#define MCP23017_GPIOB   0x13
+#define MCP23017_OLATA   0x14
+
+/**
+ * @brief Matrix behind an MCP23017: columns on port A, rows on port B.
+ *
+ * Rows use the internal pull-ups and read LOW when pressed. The selected column is the only
+ * port A pin configured as output (latched LOW); idle columns are high-impedance inputs, so two
+ * keys in the same row cannot short two driven columns. Each column costs exactly one register
+ * write (IODIRA) and one register read (GPIOB, pointer write and read joined by a repeated start),
+ * instead of one bus transaction per `digitalRead`.
+ *
+ * `Bus` is any class with the TwoWire transaction API, which lets a host-side mock stand in for
+ * the bus and count transactions.
+ */
+template <class Bus = TwoWire>
+class KeypadMCP23017 : public KeypadDriver {
+    public:
+        KeypadMCP23017(Bus &bus = Wire, uint8_t address = 0x20) : _bus(bus), _address(address) {}
+
+        void begin(byte numRows, byte numCols) override
+        {
+            _rowMask = (numRows >= 8) ? 0xFF : (1 << numRows) - 1;
+            writeRegister(MCP23017_OLATA, 0x00);
+            writeRegister(MCP23017_IODIRA, 0xFF);
+            writeRegister(MCP23017_IODIRB, 0xFF);
+            writeRegister(MCP23017_GPPUB, _rowMask);
+            (void)numCols;
+        }
+
+        void select(byte col) override
+        {
+            writeRegister(MCP23017_IODIRA, (uint8_t)~(1 << col));
+        }
+
+        KeypadLineMask read() override
+        {
+            _bus.beginTransmission(_address);
+            _bus.write(MCP23017_GPIOB);
+            _bus.endTransmission(false);
+            _bus.requestFrom(_address, (uint8_t)1);
+            return (uint8_t)~_bus.read() & _rowMask;
+        }
+
+        void deselect(byte col) override
+        {
+            (void)col;  // the next select() rewrites the whole IODIRA register
+        }
+
+    private:
+        Bus &_bus;
+        uint8_t _address;
+        uint8_t _rowMask = 0xFF;
+
+        void writeRegister(uint8_t reg, uint8_t value)
+        {
+            _bus.beginTransmission(_address);
+            _bus.write(reg);
+            _bus.write(value);
+            _bus.endTransmission();
+        }
+};
+
+/**
+ * @brief Matrix behind a PCF8574: columns on P0.., rows on the following pins.
+ *
+ * The PCF8574 has no registers: one byte write drives the selected column LOW and leaves every
+ * other pin weakly HIGH (usable as input), one byte read returns all rows. A column therefore
+ * costs one write and one read transaction. Rows read LOW when pressed.
+ *
+ * `Bus` is any class with the TwoWire transaction API.
+ */
+template <class Bus = TwoWire>
+class KeypadPCF8574 : public KeypadDriver {
+    public:
+        KeypadPCF8574(Bus &bus = Wire, uint8_t address = 0x20) : _bus(bus), _address(address) {}
+
+        void begin(byte numRows, byte numCols) override
+        {
+            _numCols = numCols;
+            _rowMask = ((1 << numRows) - 1) & 0xFF;
+            write(0xFF);
+        }
+
+        void select(byte col) override
+        {
+            write((uint8_t)~(1 << col));
+        }
+
+        KeypadLineMask read() override
+        {
+            _bus.requestFrom(_address, (uint8_t)1);
+            return (uint8_t)(~_bus.read() >> _numCols) & _rowMask;
+        }
+
+        void deselect(byte col) override
+        {
+            (void)col;  // the next select() drives all columns at once
+        }
+
+    private:
+        Bus &_bus;
+        uint8_t _address;
+        uint8_t _numCols = 0;
+        uint8_t _rowMask = 0;
+
+        void write(uint8_t value)
+        {
+            _bus.beginTransmission(_address);
+            _bus.write(value);
+            _bus.endTransmission();
+        }
+};
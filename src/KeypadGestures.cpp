@@ -0,0 +1,177 @@
+/**
+ * @file KeypadGestures.cpp
+ * @brief Implementation of the KeypadGestures class for tap, multi-tap and tap-hold recognition.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadGestures.h"
+#include "CustomKeypad.h"
+
+/**
+ * @brief Sets the tap window.
+ *
+ * A release starts the tap window; a new press of the same key inside it counts as the next tap
+ * of the same gesture, otherwise the taps seen so far are resolved.
+ *
+ * @param window The tap window in milliseconds.
+ * @return None
+ * @note Updates the member variable `_tapWindow`.
+ */
+void KeypadGestures::setTapWindow(unsigned int window)
+{
+    _tapWindow = window;
+}
+
+/**
+ * @brief Sets the hold window.
+ *
+ * A press longer than this is not a tap: after one or more taps it resolves as KEY_TAP_HOLD,
+ * on its own it is left to the keypad's regular hold events.
+ *
+ * @param window The hold window in milliseconds.
+ * @return None
+ * @note Updates the member variable `_holdWindow`.
+ */
+void KeypadGestures::setHoldWindow(unsigned int window)
+{
+    _holdWindow = window;
+}
+
+/**
+ * @brief Feeds a key event from `CustomKeypad::readEvent()`.
+ *
+ * Only KEY_PRESSED and KEY_RELEASED are used. Each key in progress has a tracker holding its
+ * state, tap count and next deadline; events only advance that state machine, the timeouts are
+ * handled by `poll()`. Deadlines that passed before the event's timestamp are resolved first, so
+ * events queued during a stalled `loop()` never join an expired gesture.
+ *
+ * @param event The key event.
+ * @return None
+ */
+void KeypadGestures::process(const KeyEvent &event)
+{
+    poll(event.time);
+
+    Tracker *t = nullptr;
+    Tracker *idle = nullptr;
+
+    for (byte i = 0; i < KEYPAD_MAX_GESTURES; i++) {
+        if (_trackers[i].state == IDLE) {
+            if (!idle) idle = &_trackers[i];
+        }
+        else if (_trackers[i].index == event.index) {
+            t = &_trackers[i];
+        }
+    }
+
+    if (event.type == KEY_PRESSED) {
+        if (!t) {
+            if (!idle) return;  // too many keys in progress
+            t = idle;
+            t->index = event.index;
+            t->key = event.key;
+            t->taps = 0;
+        }
+        if (t->state == DONE) return;
+        t->state = DOWN;
+        t->deadline = event.time + _holdWindow;
+    }
+    else if (event.type == KEY_RELEASED && t) {
+        if (t->state == DONE) {
+            t->state = IDLE;
+        }
+        else if (t->state == DOWN) {
+            t->taps++;
+            t->state = UP;
+            t->deadline = event.time + _tapWindow;
+            if (t->taps == 3) resolve(*t, KEY_TRIPLE_TAP, event.time);
+        }
+    }
+    else {
+        return;
+    }
+
+    schedule();
+}
+
+/**
+ * @brief Resolves gestures whose deadline has passed.
+ *
+ * Only the earliest pending deadline is compared on each call, so calling this every loop costs
+ * a single comparison while no gesture is due.
+ *
+ * @param now Current time in milliseconds.
+ * @return None
+ */
+void KeypadGestures::poll(unsigned long now)
+{
+    if (!_armed || (long)(now - _nextDeadline) < 0) return;
+
+    for (byte i = 0; i < KEYPAD_MAX_GESTURES; i++) {
+        Tracker &t = _trackers[i];
+        if ((t.state != DOWN && t.state != UP) || (long)(now - t.deadline) < 0) continue;
+
+        if (t.state == UP) {
+            resolve(t, t.taps == 1 ? KEY_TAP : KEY_DOUBLE_TAP, t.deadline);
+        }
+        else if (t.taps) {
+            resolve(t, KEY_TAP_HOLD, t.deadline);
+        }
+        else {
+            t.state = DONE;  // plain long press, not a gesture
+        }
+    }
+
+    schedule();
+}
+
+/**
+ * @brief Retrieves the next resolved gesture.
+ *
+ * @param event Receives the gesture with type KEY_TAP, KEY_DOUBLE_TAP, KEY_TRIPLE_TAP or
+ *              KEY_TAP_HOLD and the key index and character.
+ * @return bool True if a gesture was available.
+ */
+bool KeypadGestures::readEvent(KeyEvent &event)
+{
+    return _events.pop(event);
+}
+
+/**
+ * @brief Queues a resolved gesture and finishes the tracker.
+ *
+ * A tracker resolved while its key is down waits for the release before it can start again.
+ *
+ * @param t The tracker.
+ * @param type The gesture event type.
+ * @param time Timestamp of the resolution.
+ * @return None
+ */
+void KeypadGestures::resolve(Tracker &t, byte type, unsigned long time)
+{
+    KeyEvent ev = { type, t.index, t.key, time };
+    _events.push(ev);
+    t.state = (t.state == DOWN) ? DONE : IDLE;
+}
+
+/**
+ * @brief Recomputes the earliest pending deadline.
+ *
+ * @param None
+ * @return None
+ * @note Updates the member variables `_nextDeadline` and `_armed`.
+ */
+void KeypadGestures::schedule()
+{
+    _armed = false;
+
+    for (byte i = 0; i < KEYPAD_MAX_GESTURES; i++) {
+        const Tracker &t = _trackers[i];
+        if (t.state != DOWN && t.state != UP) continue;
+        if (!_armed || (long)(t.deadline - _nextDeadline) < 0) {
+            _nextDeadline = t.deadline;
+            _armed = true;
+        }
+    }
+}
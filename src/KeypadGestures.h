@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadEvents.h"
+
+
+#ifndef KEYPAD_MAX_GESTURES
+#define KEYPAD_MAX_GESTURES  4  ///< Keys whose gestures can be in progress at the same time.
+#endif
+
+class KeypadGestures {
+    public:
+        void setTapWindow(unsigned int window);
+        void setHoldWindow(unsigned int window);
+
+        void process(const KeyEvent &event);
+        void poll(unsigned long now);
+        bool readEvent(KeyEvent &event);
+
+    private:
+        enum { IDLE, DOWN, UP, DONE };
+
+        struct Tracker {
+            byte state;
+            KeypadKeyIndex index;
+            char key;
+            byte taps;
+            unsigned long deadline;
+        };
+
+        Tracker _trackers[KEYPAD_MAX_GESTURES] = {};
+        KeyEventQueue _events;
+        unsigned int _tapWindow = 250;
+        unsigned int _holdWindow = 300;
+        unsigned long _nextDeadline = 0;
+        bool _armed = false;
+
+        void resolve(Tracker &t, byte type, unsigned long time);
+        void schedule();
+};
@@ -0,0 +1,166 @@
+/**
+ * @file KeypadGroup.cpp
+ * @brief Implementation of the KeypadGroup class for keypads that share row lines.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadGroup.h"
+#include "CustomKeypad.h"
+
+/**
+ * @brief Constructs a group around a set of shared row pins.
+ *
+ * @param rows Array of pin numbers for the shared rows.
+ * @param numRows Number of shared rows.
+ * @return None
+ */
+KeypadGroup::KeypadGroup(byte *rows, byte numRows) : _lines(rows, _cols)
+{
+    _numRows = numRows;
+}
+
+/**
+ * @brief Adds a keypad to the group.
+ *
+ * The keypad must be constructed with direct pins, the shared row pins and its own column pins.
+ * Its columns are appended to the merged scan schedule, except those without populated keys.
+ * From now on the group owns the lines: the keypad's `begin()` does nothing and its `update()`
+ * scans the whole group. Each merged column still waits the settle time the keypad has for it,
+ * so `setSettleTime()` on the keypad keeps working.
+ *
+ * @param keypad The keypad to add.
+ * @return bool True if added, false if the group is full, the keypad does not use direct pins
+ *         on the shared row pins, or it has priority keys or hot scan (not supported in groups).
+ */
+bool KeypadGroup::add(CustomKeypad &keypad)
+{
+    if (_count >= KEYPAD_GROUP_MAX_PADS) return false;
+    if (keypad._priorityCount || keypad._sweepEvery) return false;
+    if (keypad._driver != &keypad._pins || keypad._numRows != _numRows) return false;
+    for (byte r = 0; r < _numRows; r++) {
+        if (keypad._pins.row(r) != _lines.row(r)) return false;
+    }
+    if (_numCols + keypad._numCols > KEYPAD_GROUP_MAX_COLS) return false;
+
+    keypad.buildScanMask();
+    for (byte c = 0; c < keypad._numCols && c < KEYPAD_MAX_STROBES; c++) {
+        bool populated = false;
+        for (byte r = 0; r < _numRows; r++) {
+            if (keypad._keymap[r][c] != NO_KEY) populated = true;
+        }
+        if (!populated) continue;
+
+        _cols[_numCols] = keypad._pins.column(c);
+        _colPad[_numCols] = _count;
+        _colIndex[_numCols] = c;
+        _numCols++;
+    }
+
+    keypad._group = this;
+    _pads[_count++] = &keypad;
+    return true;
+}
+
+/**
+ * @brief Configures the shared rows once and every column of every keypad.
+ *
+ * @param None
+ * @return None
+ * @note Calls `KeypadPinDriver::begin()` for the merged lines.
+ */
+void KeypadGroup::begin()
+{
+    _lines.begin(_numRows, _numCols);
+}
+
+/**
+ * @brief Scans every keypad of the group and generates their events.
+ *
+ * @param None
+ * @return bool True if the debounced matrix of any keypad changed.
+ */
+bool KeypadGroup::update()
+{
+    return scan() != 0;
+}
+
+/**
+ * @brief Scans the group on behalf of one keypad's `update()`.
+ *
+ * @param keypad The keypad whose result is returned.
+ * @return bool True if the debounced matrix of that keypad changed.
+ */
+bool KeypadGroup::update(CustomKeypad &keypad)
+{
+    byte changed = scan();
+
+    for (byte p = 0; p < _count; p++) {
+        if (_pads[p] == &keypad) return (changed >> p) & 1;
+    }
+    return false;
+}
+
+/**
+ * @brief Runs the merged column schedule and hands each keypad its own bitmap.
+ *
+ * Each merged column is driven once and the shared rows are sampled once for it; the result
+ * belongs to exactly one keypad, so it is set into that keypad's bitmap at `row * numCols + col`.
+ * Every keypad then debounces and generates events from its bitmap as if it had scanned alone.
+ * As in `CustomKeypad::scanMatrix()`, the next column settles while the previous one is merged,
+ * for the settle time its keypad has for it, and columns whose keys are all disabled or priority
+ * keys are skipped.
+ *
+ * @param None
+ * @return byte Bit p set if the debounced matrix of keypad p changed.
+ * @note Uses Arduino `millis` and `micros` functions for timing.
+ */
+byte KeypadGroup::scan()
+{
+    KeypadBitmap raw[KEYPAD_GROUP_MAX_PADS];
+    unsigned long selectedAt = 0;
+
+    byte s = nextColumn(0);
+    if (s < _numCols) {
+        _lines.select(s);
+        selectedAt = micros();
+    }
+
+    while (s < _numCols) {
+        _pads[_colPad[s]]->_driver->waitSettled(_colIndex[s], selectedAt);
+        KeypadLineMask rows = _lines.read();
+        _lines.deselect(s);
+
+        byte next = nextColumn(s + 1);
+        if (next < _numCols) {
+            _lines.select(next);
+            selectedAt = micros();
+        }
+
+        _pads[_colPad[s]]->mergeLines(raw[_colPad[s]], _colIndex[s], rows);
+        s = next;
+    }
+
+    unsigned long now = millis();
+    byte changed = 0;
+    for (byte p = 0; p < _count; p++) {
+        if (_pads[p]->process(raw[p], now)) changed |= 1 << p;
+    }
+    return changed;
+}
+
+/**
+ * @brief Finds the next merged column with keys to read.
+ *
+ * The owning keypad's current scan mask decides, so `setEnabledKeys()` takes effect at once.
+ *
+ * @param from First merged column to consider.
+ * @return byte The merged column, or `_numCols` if none is left.
+ */
+byte KeypadGroup::nextColumn(byte from)
+{
+    for (; from < _numCols; from++) {
+        if (_pads[_colPad[from]]->_scanMask[_colIndex[from]]) break;
+    }
+    return from;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadBitmap.h"
+#include "KeypadPinDriver.h"
+
+
+#ifndef KEYPAD_GROUP_MAX_PADS
+#define KEYPAD_GROUP_MAX_PADS  4   ///< Keypads sharing one set of row lines.
+#endif
+
+#ifndef KEYPAD_GROUP_MAX_COLS
+#define KEYPAD_GROUP_MAX_COLS  16  ///< Columns of all keypads in a group together.
+#endif
+
+class CustomKeypad;
+
+class KeypadGroup {
+    public:
+        KeypadGroup(byte *rows, byte numRows);
+
+        bool add(CustomKeypad &keypad);
+        void begin();
+        bool update();
+
+    private:
+        friend class CustomKeypad;
+
+        byte _cols[KEYPAD_GROUP_MAX_COLS];     // merged column pins, in scan order
+        byte _colPad[KEYPAD_GROUP_MAX_COLS];   // keypad owning each merged column
+        byte _colIndex[KEYPAD_GROUP_MAX_COLS]; // column number within that keypad
+        byte _numCols = 0;
+        byte _numRows;
+        KeypadPinDriver _lines;
+
+        CustomKeypad *_pads[KEYPAD_GROUP_MAX_PADS];
+        byte _count = 0;
+
+        byte scan();
+        byte nextColumn(byte from);
+        bool update(CustomKeypad &keypad);
+};
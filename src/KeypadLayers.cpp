@@ -0,0 +1,168 @@
+/**
+ * @file KeypadLayers.cpp
+ * @brief Implementation of the KeypadLayers class for stacked keymaps with layer-switch keys.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadLayers.h"
+#include "CustomKeypad.h"
+
+/**
+ * @brief Constructs a layer stack with only the base keymap.
+ *
+ * Layer 0 is the keypad's own keymap; layers 1 and up are added with `addLayer()`.
+ *
+ * @param None
+ * @return None
+ */
+KeypadLayers::KeypadLayers()
+{
+    for (byte l = 0; l < KEYPAD_MAX_LAYERS; l++) {
+        _maps[l] = nullptr;
+        _moIndex[l] = KEYPAD_NO_INDEX;
+    }
+}
+
+/**
+ * @brief Adds a keymap layer.
+ *
+ * The keymap is a flash array in the same row/column layout as the base keymap, e.g.
+ * `const char fn[ROWS][COLS] PROGMEM`, passed as `&fn[0][0]`. Entries may be KEY_TRANSPARENT
+ * to fall through to lower layers, or KEY_MO(n) / KEY_TG(n) layer-switch keys.
+ *
+ * @param layer Layer number, 1 to KEYPAD_MAX_LAYERS - 1. Higher layers take precedence.
+ * @param keymap Pointer to the layer keymap in flash (PROGMEM).
+ * @return bool True if the layer was added.
+ */
+bool KeypadLayers::addLayer(byte layer, const char *keymap)
+{
+    if (layer == 0 || layer >= KEYPAD_MAX_LAYERS || !keymap) return false;
+
+    _maps[layer] = keymap;
+    _defined |= (1 << layer);
+    refresh();
+    return true;
+}
+
+/**
+ * @brief Turns a layer on or off from the sketch.
+ *
+ * @param layer Layer number.
+ * @param on True to activate the layer.
+ * @return None
+ */
+void KeypadLayers::setLayer(byte layer, bool on)
+{
+    if (layer >= KEYPAD_MAX_LAYERS) return;
+
+    if (on) _toggled |= (1 << layer);
+    else _toggled &= ~(1 << layer);
+    refresh();
+}
+
+/**
+ * @brief Flips a toggled layer from the sketch.
+ *
+ * @param layer Layer number.
+ * @return None
+ */
+void KeypadLayers::toggleLayer(byte layer)
+{
+    if (layer >= KEYPAD_MAX_LAYERS) return;
+
+    _toggled ^= (1 << layer);
+    refresh();
+}
+
+/**
+ * @brief Retrieves the active layers.
+ *
+ * @param None
+ * @return byte Bitmask with bit n set when layer n is active; bit 0 is always set.
+ */
+byte KeypadLayers::getActiveLayers()
+{
+    return _active;
+}
+
+/**
+ * @brief Resolves the character of a key through the active layers.
+ *
+ * Walks the precomputed active-layer mask from the highest layer down and returns the first
+ * entry that is not KEY_TRANSPARENT, so the cost is at most one flash read per layer.
+ *
+ * @param index The key index `row * numCols + col`.
+ * @param base The character of the key in the base keymap.
+ * @return char The resolved character or layer-switch code.
+ */
+char KeypadLayers::resolve(KeypadKeyIndex index, char base)
+{
+    byte active = _active & ~1;
+
+    while (active) {
+        byte layer = sizeof(unsigned int) * 8 - 1 - __builtin_clz(active);
+        char c = pgm_read_byte(_maps[layer] + index);
+        if (c != KEY_TRANSPARENT) return c;
+        active &= ~(1 << layer);
+    }
+    return base;
+}
+
+/**
+ * @brief Consumes the press and release events of layer-switch keys.
+ *
+ * KEY_MO(n) activates layer n until the same key is released, KEY_TG(n) flips it on press.
+ * Neither produces key events of its own.
+ *
+ * @param event A press or release event with the resolved key character.
+ * @return bool True if the event belonged to a layer-switch key and must not be delivered.
+ */
+bool KeypadLayers::handle(const KeyEvent &event)
+{
+    if (event.type == KEY_PRESSED) {
+        byte code = (byte)event.key;
+        byte layer = code & 0x07;
+
+        if ((code & 0xF8) == 0xC0) {
+            _momentary |= (1 << layer);
+            _moIndex[layer] = event.index;
+        }
+        else if ((code & 0xF8) == 0xE0) {
+            _toggled ^= (1 << layer);
+        }
+        else {
+            return false;
+        }
+
+        _layerKeys.set(event.index);
+        refresh();
+        return true;
+    }
+
+    if (event.type == KEY_RELEASED && _layerKeys.test(event.index)) {
+        _layerKeys.reset(event.index);
+        for (byte l = 0; l < KEYPAD_MAX_LAYERS; l++) {
+            if (_moIndex[l] == event.index) {
+                _momentary &= ~(1 << l);
+                _moIndex[l] = KEYPAD_NO_INDEX;
+            }
+        }
+        refresh();
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Recomputes the active-layer mask after a layer change.
+ *
+ * @param None
+ * @return None
+ * @note Updates the member variable `_active`.
+ */
+void KeypadLayers::refresh()
+{
+    _active = 1 | ((_momentary | _toggled) & _defined);
+}
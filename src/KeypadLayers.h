@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadBitmap.h"
+#include "KeypadEvents.h"
+
+
+#define KEYPAD_MAX_LAYERS   8  ///< Layers including the base keymap (layer 0).
+
+/**
+ * @brief Special keymap codes understood by KeypadLayers.
+ */
+#define KEY_TRANSPARENT     ((char)0x80)         ///< Falls through to the next lower active layer.
+#define KEY_MO(n)           ((char)(0xC0 | (n))) ///< Layer n active while the key is held.
+#define KEY_TG(n)           ((char)(0xE0 | (n))) ///< Layer n toggled on each press.
+
+class KeypadLayers {
+    public:
+        KeypadLayers();
+
+        bool addLayer(byte layer, const char *keymap);
+        void setLayer(byte layer, bool on);
+        void toggleLayer(byte layer);
+        byte getActiveLayers();
+        char resolve(KeypadKeyIndex index, char base);
+
+    private:
+        friend class CustomKeypad;
+
+        const char *_maps[KEYPAD_MAX_LAYERS];
+        byte _defined = 0;
+        byte _momentary = 0;
+        byte _toggled = 0;
+        byte _active = 1;
+        KeypadKeyIndex _moIndex[KEYPAD_MAX_LAYERS];
+        KeypadBitmap _layerKeys;
+
+        bool handle(const KeyEvent &event);
+        void refresh();
+};
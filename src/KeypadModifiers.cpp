@@ -0,0 +1,97 @@
+/**
+ * @file KeypadModifiers.cpp
+ * @brief Implementation of the KeypadModifiers class for Shift/Fn keys with alternate keymaps.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadModifiers.h"
+#include "CustomKeypad.h"
+
+/**
+ * @brief Constructs an empty modifier table for a keypad.
+ *
+ * The table only takes effect once attached with `CustomKeypad::setModifiers()`.
+ *
+ * @param keypad The keypad whose keymap resolves modifier keys.
+ * @return None
+ */
+KeypadModifiers::KeypadModifiers(CustomKeypad &keypad) : _keypad(keypad)
+{
+}
+
+/**
+ * @brief Designates a key as a modifier with its own keymap.
+ *
+ * While the modifier is held, other keys produce the character from its keymap. The keymap is a
+ * flash array in the same row/column layout as the base keymap, e.g.
+ * `const char shifted[ROWS][COLS] PROGMEM`, passed as `&shifted[0][0]`; KEY_TRANSPARENT entries
+ * keep the unmodified character. The modifier key itself produces no events. When several
+ * modifiers are held, the one added first wins.
+ *
+ * @param key Character of the modifier key in the base keymap.
+ * @param keymap Pointer to the modifier keymap in flash (PROGMEM).
+ * @return bool True if added, false if the table is full or the key is unknown.
+ */
+bool KeypadModifiers::addModifier(char key, const char *keymap)
+{
+    int index = _keypad.findKey(key);
+    if (_count >= KEYPAD_MAX_MODIFIERS || index < 0 || !keymap) return false;
+
+    _keys[_count] = index;
+    _maps[_count] = keymap;
+    _count++;
+    _mask.set(index);
+    return true;
+}
+
+/**
+ * @brief Retrieves the held modifiers.
+ *
+ * @param None
+ * @return byte Bitmask with bit m set while the m-th added modifier is held.
+ */
+byte KeypadModifiers::getActiveModifiers()
+{
+    const KeypadBitmap &state = _keypad.getKeyBitmap();
+    byte active = 0;
+
+    for (byte m = 0; m < _count; m++) {
+        if (state.test(_keys[m])) active |= 1 << m;
+    }
+    return active;
+}
+
+/**
+ * @brief Resolves the character of a key under the held modifiers.
+ *
+ * The debounced state is tested against the precomputed mask of all modifier keys first, so with
+ * no modifier held the cost is one AND per bitmap word.
+ *
+ * @param index The key index `row * numCols + col`.
+ * @param state The debounced key state.
+ * @return char The modified character, or KEY_TRANSPARENT if no held modifier changes the key.
+ */
+char KeypadModifiers::resolve(KeypadKeyIndex index, const KeypadBitmap &state)
+{
+    KeypadBitmap held = state & _mask;
+    if (!held.any()) return KEY_TRANSPARENT;
+
+    for (byte m = 0; m < _count; m++) {
+        if (!held.test(_keys[m])) continue;
+        char c = pgm_read_byte(_maps[m] + index);
+        if (c != KEY_TRANSPARENT) return c;
+    }
+    return KEY_TRANSPARENT;
+}
+
+/**
+ * @brief Consumes the press and release events of modifier keys.
+ *
+ * @param event A press or release event.
+ * @return bool True if the event belonged to a modifier key and must not be delivered.
+ */
+bool KeypadModifiers::handle(const KeyEvent &event)
+{
+    return (event.type == KEY_PRESSED || event.type == KEY_RELEASED) && _mask.test(event.index);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadBitmap.h"
+#include "KeypadEvents.h"
+#include "KeypadLayers.h"
+
+
+#ifndef KEYPAD_MAX_MODIFIERS
+#define KEYPAD_MAX_MODIFIERS  4  ///< Modifier keys per KeypadModifiers object.
+#endif
+
+class CustomKeypad;
+
+class KeypadModifiers {
+    public:
+        KeypadModifiers(CustomKeypad &keypad);
+
+        bool addModifier(char key, const char *keymap);
+        byte getActiveModifiers();
+
+    private:
+        friend class CustomKeypad;
+
+        CustomKeypad &_keypad;
+        KeypadKeyIndex _keys[KEYPAD_MAX_MODIFIERS];
+        const char *_maps[KEYPAD_MAX_MODIFIERS];
+        byte _count = 0;
+        KeypadBitmap _mask;  // every modifier key
+
+        char resolve(KeypadKeyIndex index, const KeypadBitmap &state);
+        bool handle(const KeyEvent &event);
+};
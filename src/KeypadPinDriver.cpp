@@ -0,0 +1,229 @@
+/**
+ * @file KeypadPinDriver.cpp
+ * @brief Implementation of the KeypadDirectPins driver for matrices wired to MCU pins.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadPinDriver.h"
+
+/**
+ * @brief Constructs a driver for rows and columns wired directly to MCU pins.
+ *
+ * With KEYPAD_ACTIVE_HIGH, rows need external pull-down resistors and a pressed key connects its
+ * row to the column driven HIGH. With KEYPAD_ACTIVE_LOW, rows use the internal pull-ups and a
+ * pressed key pulls its row to the column driven LOW; no resistor network is needed.
+ *
+ * @param rows Array of pin numbers for keypad rows.
+ * @param cols Array of pin numbers for keypad columns.
+ * @return None
+ */
+template <KeypadPolarity Polarity>
+KeypadDirectPins<Polarity>::KeypadDirectPins(byte *rows, byte *cols)
+{
+    _rows = rows;
+    _cols = cols;
+    for (byte c = 0; c < KEYPAD_MAX_STROBES; c++) _settle[c] = KEYPAD_SETTLE_US;
+}
+
+/**
+ * @brief Initializes the keypad by configuring pin modes for rows and columns.
+ *
+ * Active-high: columns are outputs held LOW and rows are plain inputs. Active-low: idle columns
+ * are high-impedance inputs, which draws no current through held keys, and rows are inputs with
+ * pull-up.
+ *
+ * @param numRows Number of rows in the keypad matrix.
+ * @param numCols Number of columns in the keypad matrix.
+ * @return None
+ * @note Uses Arduino `pinMode` and `digitalWrite` functions.
+ */
+template <KeypadPolarity Polarity>
+void KeypadDirectPins<Polarity>::begin(byte numRows, byte numCols)
+{
+    _numRows = numRows;
+    _numCols = numCols;
+
+    for (byte c = 0; c < _numCols; c++) {
+        if (Polarity == KEYPAD_ACTIVE_LOW) {
+            pinMode(_cols[c], INPUT);
+        } else {
+            pinMode(_cols[c], OUTPUT);
+            digitalWrite(_cols[c], LOW);
+        }
+    }
+
+    for (byte r = 0; r < _numRows; r++) {
+        pinMode(_rows[r], (Polarity == KEYPAD_ACTIVE_LOW) ? INPUT_PULLUP : INPUT);
+    }
+}
+
+/**
+ * @brief Drives a column to its active level.
+ *
+ * Returns immediately; the scan waits out `settleTime()` before reading, and does its own work in
+ * the meantime.
+ *
+ * @param col Column number.
+ * @return None
+ * @note Uses Arduino `pinMode` and `digitalWrite` functions.
+ */
+template <KeypadPolarity Polarity>
+void KeypadDirectPins<Polarity>::select(byte col)
+{
+    if (Polarity == KEYPAD_ACTIVE_LOW) {
+        digitalWrite(_cols[col], LOW);
+        pinMode(_cols[col], OUTPUT);
+    } else {
+        digitalWrite(_cols[col], HIGH);
+    }
+}
+
+/**
+ * @brief Returns the settle time of a column.
+ *
+ * KEYPAD_SETTLE_US unless calibrated or overridden.
+ *
+ * @param col Column number.
+ * @return unsigned int Settle time in microseconds.
+ */
+template <KeypadPolarity Polarity>
+unsigned int KeypadDirectPins<Polarity>::settleTime(byte col)
+{
+    return _settle[(col < KEYPAD_MAX_STROBES) ? col : KEYPAD_MAX_STROBES - 1];
+}
+
+/**
+ * @brief Reads every row pin.
+ *
+ * @param None
+ * @return KeypadLineMask Bit r set for each row at the active level.
+ * @note Uses Arduino `digitalRead` function.
+ */
+template <KeypadPolarity Polarity>
+KeypadLineMask KeypadDirectPins<Polarity>::read()
+{
+    const int active = (Polarity == KEYPAD_ACTIVE_LOW) ? LOW : HIGH;
+    KeypadLineMask rows = 0;
+
+    for (byte r = 0; r < _numRows; r++) {
+        if (digitalRead(_rows[r]) == active) rows |= (KeypadLineMask)1 << r;
+    }
+    return rows;
+}
+
+/**
+ * @brief Returns a column to idle: LOW when active-high, high-impedance when active-low.
+ *
+ * @param col Column number.
+ * @return None
+ * @note Uses Arduino `pinMode` and `digitalWrite` functions.
+ */
+template <KeypadPolarity Polarity>
+void KeypadDirectPins<Polarity>::deselect(byte col)
+{
+    if (Polarity == KEYPAD_ACTIVE_LOW) {
+        pinMode(_cols[col], INPUT);
+    } else {
+        digitalWrite(_cols[col], LOW);
+    }
+}
+
+/**
+ * @brief Swaps the roles of the row and column pins.
+ *
+ * The matrix is symmetric for direct pins, so strobing rows and sensing columns only exchanges the
+ * two pin arrays. The sensed lines must carry the pull resistors of the chosen polarity: the
+ * internal pull-ups of KEYPAD_ACTIVE_LOW are on every pin, but the external pull-downs of
+ * KEYPAD_ACTIVE_HIGH are only on the rows, so that wiring keeps strobing columns.
+ *
+ * @param transposed True to strobe rows and sense columns.
+ * @return bool True if the orientation was applied.
+ */
+template <KeypadPolarity Polarity>
+bool KeypadDirectPins<Polarity>::setTransposed(bool transposed)
+{
+    if (Polarity == KEYPAD_ACTIVE_HIGH) return !transposed;  // columns have no pull-downs
+
+    if (transposed != _transposed) {
+        byte *lines = _rows;
+        _rows = _cols;
+        _cols = lines;
+        _transposed = transposed;
+    }
+    return true;
+}
+
+/**
+ * @brief Sets the settle time of every column.
+ *
+ * @param us Settle wait in microseconds.
+ * @return None
+ * @note Updates the member variable `_settle`.
+ */
+template <KeypadPolarity Polarity>
+void KeypadDirectPins<Polarity>::setSettleTime(unsigned int us)
+{
+    for (byte c = 0; c < KEYPAD_MAX_STROBES; c++) _settle[c] = us;
+}
+
+/**
+ * @brief Overrides the settle time of one column, e.g. a long cable run to one connector.
+ *
+ * @param col Column number (the strobed line, a row when the scan is transposed).
+ * @param us Settle wait in microseconds.
+ * @return None
+ * @note Updates the member variable `_settle`.
+ */
+template <KeypadPolarity Polarity>
+void KeypadDirectPins<Polarity>::setSettleTime(byte col, unsigned int us)
+{
+    if (col < KEYPAD_MAX_STROBES) _settle[col] = us;
+}
+
+/**
+ * @brief Measures the settle time of the board and applies it to every column.
+ *
+ * A row settles after a column change by discharging its trace and cable through the pull
+ * resistor. Each row is charged to the active level as an output, released to its input mode,
+ * and the time until it reads idle again is measured. The slowest row, doubled for margin, becomes
+ * the settle time. Columns are released to high-impedance meanwhile so a held key cannot short a
+ * charged row to a driven column.
+ *
+ * @param None
+ * @return unsigned int The settle time set, in microseconds.
+ * @note Call after `begin()`. Uses Arduino `pinMode`, `digitalWrite`, `digitalRead` and `micros`
+ *       functions.
+ */
+template <KeypadPolarity Polarity>
+unsigned int KeypadDirectPins<Polarity>::calibrateSettle()
+{
+    const int active = (Polarity == KEYPAD_ACTIVE_LOW) ? LOW : HIGH;
+    const byte idleMode = (Polarity == KEYPAD_ACTIVE_LOW) ? INPUT_PULLUP : INPUT;
+    unsigned long worst = 0;
+
+    for (byte c = 0; c < _numCols; c++) pinMode(_cols[c], INPUT);
+
+    for (byte r = 0; r < _numRows; r++) {
+        digitalWrite(_rows[r], active);
+        pinMode(_rows[r], OUTPUT);
+        delayMicroseconds(5);  // charge the line
+        pinMode(_rows[r], idleMode);
+
+        unsigned long start = micros();
+        unsigned long elapsed = 0;
+        while (digitalRead(_rows[r]) == active && elapsed < KEYPAD_SETTLE_TIMEOUT_US) {
+            elapsed = micros() - start;
+        }
+        if (elapsed > worst) worst = elapsed;
+    }
+
+    begin(_numRows, _numCols);  // restore the idle column and row modes
+
+    unsigned int settle = worst * 2 + 1;
+    setSettleTime(settle);
+    return settle;
+}
+
+template class KeypadDirectPins<KEYPAD_ACTIVE_HIGH>;
+template class KeypadDirectPins<KEYPAD_ACTIVE_LOW>;
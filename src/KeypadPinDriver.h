@@ -0,0 +1,52 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadDriver.h"
+
+
+#ifndef KEYPAD_SETTLE_TIMEOUT_US
+#define KEYPAD_SETTLE_TIMEOUT_US  1000  ///< Longest line discharge measured by calibrateSettle().
+#endif
+
+/**
+ * @brief Electrical polarity of a matrix wired to MCU pins.
+ */
+enum KeypadPolarity {
+    KEYPAD_ACTIVE_HIGH,  ///< External pull-downs on the rows; the selected column is driven HIGH.
+    KEYPAD_ACTIVE_LOW    ///< Internal pull-ups on the rows; the selected column is driven LOW.
+};
+
+/**
+ * @brief Matrix wired directly to MCU pins.
+ *
+ * The polarity is a template parameter, so the select and read paths are resolved at compile
+ * time and the scan loop carries no wiring checks.
+ */
+template <KeypadPolarity Polarity>
+class KeypadDirectPins : public KeypadDriver {
+    public:
+        KeypadDirectPins(byte *rows, byte *cols);
+
+        void begin(byte numRows, byte numCols) override;
+        void select(byte col) override;
+        unsigned int settleTime(byte col) override;
+        KeypadLineMask read() override;
+        void deselect(byte col) override;
+        bool setTransposed(bool transposed) override;
+        void setSettleTime(unsigned int us) override;
+        void setSettleTime(byte col, unsigned int us) override;
+        unsigned int calibrateSettle() override;
+
+        byte row(byte r) const { return _rows[r]; }
+        byte column(byte col) const { return _cols[col]; }
+
+    protected:
+        byte *_rows;   // sensed lines
+        byte *_cols;   // strobed lines
+        bool _transposed = false;
+        byte _numRows = 0;
+        byte _numCols = 0;
+        uint16_t _settle[KEYPAD_MAX_STROBES];  // settle wait per strobed line, microseconds
+};
+
+typedef KeypadDirectPins<KEYPAD_ACTIVE_HIGH> KeypadPinDriver;     ///< External pull-down wiring.
+typedef KeypadDirectPins<KEYPAD_ACTIVE_LOW>  KeypadPullupDriver;  ///< Internal pull-up wiring.
@@ -0,0 +1,100 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadPinDriver.h"
+
+
+#define KEYPAD_NO_BIT  0xFF  ///< Row is not on the port described by a KeypadPortTable.
+
+/**
+ * @brief Compile-time helpers that build the gather tables.
+ */
+template <unsigned... I> struct KeypadIndexList {};
+
+template <unsigned N, unsigned... I>
+struct KeypadMakeIndices : KeypadMakeIndices<N - 1, N - 1, I...> {};
+
+template <unsigned... I>
+struct KeypadMakeIndices<0, I...> {
+    typedef KeypadIndexList<I...> type;
+};
+
+constexpr KeypadLineMask keypadGatherRows(unsigned value, byte row)
+{
+    return (void)value, (void)row, 0;
+}
+
+template <class... Bits>
+constexpr KeypadLineMask keypadGatherRows(unsigned value, byte row, uint8_t bit, Bits... rest)
+{
+    return ((bit != KEYPAD_NO_BIT && ((value >> bit) & 1)) ? (KeypadLineMask)1 << row : 0) |
+           keypadGatherRows(value, row + 1, rest...);
+}
+
+template <class Indices, uint8_t... Bits> struct KeypadPortTableData;
+
+template <unsigned... I, uint8_t... Bits>
+struct KeypadPortTableData<KeypadIndexList<I...>, Bits...> {
+    static const KeypadLineMask table[256];
+};
+
+template <unsigned... I, uint8_t... Bits>
+const KeypadLineMask KeypadPortTableData<KeypadIndexList<I...>, Bits...>::table[256] PROGMEM = {
+    keypadGatherRows(I, 0, Bits...)...
+};
+
+/**
+ * @brief Flash table mapping one port's input byte to the row bits it carries.
+ *
+ * The k-th template argument is the port bit of row k, or KEYPAD_NO_BIT when row k is on another
+ * port. Entry v of `table` is the row mask for port value v; it is computed by the compiler, so a
+ * pin list change never goes out of sync with the table. Each table takes
+ * `256 * sizeof(KeypadLineMask)` bytes of flash.
+ */
+template <uint8_t... Bits>
+struct KeypadPortTable : KeypadPortTableData<typename KeypadMakeIndices<256>::type, Bits...> {};
+
+/**
+ * @brief One port read by KeypadGatherPins: its input register and its KeypadPortTable.
+ */
+struct KeypadPortGather {
+    volatile uint8_t *reg;
+    const KeypadLineMask *table;
+};
+
+/**
+ * @brief Direct pin matrix whose rows are scattered over a few ports.
+ *
+ * Instead of one `digitalRead` per row, every port holding rows is read once per column and
+ * translated to row bits through its flash table, so reading all rows costs O(ports), not
+ * O(rows). Columns, polarity, settle time and orientation behave as with KeypadDirectPins; the
+ * tables describe the sensed lines, so they must list the columns when rows are strobed.
+ */
+template <KeypadPolarity Polarity>
+class KeypadGatherPins : public KeypadDirectPins<Polarity> {
+    public:
+        KeypadGatherPins(byte *rows, byte *cols, const KeypadPortGather *ports, byte numPorts)
+            : KeypadDirectPins<Polarity>(rows, cols), _ports(ports), _numPorts(numPorts) {}
+
+        KeypadLineMask read() override
+        {
+            KeypadLineMask rows = 0;
+
+            for (byte i = 0; i < _numPorts; i++) {
+                uint8_t value = *_ports[i].reg;
+                if (Polarity == KEYPAD_ACTIVE_LOW) value = ~value;
+                rows |= lookup(_ports[i].table + value);
+            }
+            return rows;
+        }
+
+    private:
+        const KeypadPortGather *_ports;
+        byte _numPorts;
+
+        static KeypadLineMask lookup(const KeypadLineMask *entry)
+        {
+            if (sizeof(KeypadLineMask) == 1) return pgm_read_byte(entry);
+            if (sizeof(KeypadLineMask) == 2) return pgm_read_word(entry);
+            return pgm_read_dword(entry);
+        }
+};
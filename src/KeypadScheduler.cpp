@@ -0,0 +1,82 @@
+/**
+ * @file KeypadScheduler.cpp
+ * @brief Implementation of the KeypadScheduler class for interleaved scanning of several keypads.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadScheduler.h"
+#include "CustomKeypad.h"
+
+/**
+ * @brief Adds a keypad to the round-robin schedule.
+ *
+ * The keypad must have its own lines, separate from every other keypad in the schedule, and is
+ * started with its own `begin()` as usual. Keypads sharing rows belong in a KeypadGroup instead.
+ *
+ * @param keypad The keypad to add.
+ * @return bool True if added, false if the schedule is full or the keypad is in a KeypadGroup.
+ */
+bool KeypadScheduler::add(CustomKeypad &keypad)
+{
+    if (_count >= KEYPAD_SCHEDULER_MAX_PADS || keypad._group) return false;
+
+    _pads[_count++] = &keypad;
+    return true;
+}
+
+/**
+ * @brief Scans every keypad with their settle times overlapped, then generates their events.
+ *
+ * Column k is selected on every keypad before the first one is read, so while keypad A settles,
+ * keypads B and C are being strobed and read. A scan of N keypads costs about one keypad's settle
+ * time per column instead of N. Columns without scanned keys are skipped per keypad. Each keypad
+ * still debounces and reports its own events, and keypads with `setHotScan()` only visit their hot
+ * lines between full sweeps. Priority keys are polled first, and each keypad is marked as
+ * scanning meanwhile, so a `pollPriority()` from an interrupt leaves its lines alone.
+ *
+ * @param None
+ * @return bool True if the debounced matrix of any keypad changed.
+ * @note Uses Arduino `millis` and `micros` functions for timing.
+ */
+bool KeypadScheduler::update()
+{
+    KeypadBitmap raw[KEYPAD_SCHEDULER_MAX_PADS];
+    unsigned long selectedAt[KEYPAD_SCHEDULER_MAX_PADS];
+    bool sweep[KEYPAD_SCHEDULER_MAX_PADS];
+    byte strobes = 0;
+
+    for (byte p = 0; p < _count; p++) {
+        _pads[p]->pollPriority();
+        _pads[p]->_scanning = true;
+        sweep[p] = _pads[p]->beginPass(raw[p]);
+        _pads[p]->_driver->beginScan();
+        byte n = _pads[p]->strobeCount();
+        if (n > strobes) strobes = n;
+    }
+
+    for (byte s = 0; s < strobes; s++) {
+        for (byte p = 0; p < _count; p++) {
+            if (s >= _pads[p]->strobeCount() || !_pads[p]->scansStrobe(s, sweep[p])) continue;
+            _pads[p]->_driver->select(s);
+            selectedAt[p] = micros();
+        }
+        for (byte p = 0; p < _count; p++) {
+            CustomKeypad *pad = _pads[p];
+            if (s >= pad->strobeCount() || !pad->scansStrobe(s, sweep[p])) continue;
+
+            pad->_driver->waitSettled(s, selectedAt[p]);
+            KeypadLineMask lines = pad->_driver->read();
+            pad->_driver->deselect(s);
+            pad->mergeStrobe(raw[p], s, lines, sweep[p]);
+        }
+    }
+
+    unsigned long now = millis();
+    bool changed = false;
+    for (byte p = 0; p < _count; p++) {
+        _pads[p]->_scanning = false;
+        if (_pads[p]->process(raw[p], now)) changed = true;
+    }
+    return changed;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadBitmap.h"
+
+
+#ifndef KEYPAD_SCHEDULER_MAX_PADS
+#define KEYPAD_SCHEDULER_MAX_PADS  4  ///< Keypads scanned round-robin by one scheduler.
+#endif
+
+class CustomKeypad;
+
+class KeypadScheduler {
+    public:
+        bool add(CustomKeypad &keypad);
+        bool update();
+
+    private:
+        CustomKeypad *_pads[KEYPAD_SCHEDULER_MAX_PADS];
+        byte _count = 0;
+};
@@ -0,0 +1,263 @@
+/**
+ * @file KeypadSequences.cpp
+ * @brief Implementation of the KeypadSequences and KeypadPin classes for key sequence matching.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadSequences.h"
+
+/**
+ * @brief Constructs a sequence matcher over a generated automaton.
+ *
+ * The automaton is an Aho-Corasick machine compiled by `tools/seqgen.py` into flash tables, so
+ * nothing is built in RAM and every sequence is matched in a single pass over the key stream.
+ *
+ * @param automaton The generated automaton description.
+ * @return None
+ */
+KeypadSequences::KeypadSequences(const KeypadAutomaton &automaton) : _automaton(automaton)
+{
+}
+
+/**
+ * @brief Sets the maximum gap between two keys of a sequence.
+ *
+ * A key arriving later than this after the previous one starts matching from scratch.
+ *
+ * @param timeout The timeout in milliseconds, 0 to disable.
+ * @return None
+ * @note Updates the member variable `_timeout`.
+ */
+void KeypadSequences::setTimeout(unsigned int timeout)
+{
+    _timeout = timeout;
+}
+
+/**
+ * @brief Advances the automaton by one key.
+ *
+ * Keys outside the automaton alphabet restart matching. The cost is one alphabet lookup and one
+ * flash table read, independent of the number of sequences.
+ *
+ * @param key The key character, e.g. from `getKey()` or a KEY_PRESSED event.
+ * @param time Timestamp of the key press in milliseconds.
+ * @return int Id of the sequence that ends with this key, or SEQ_NO_MATCH.
+ */
+int KeypadSequences::feed(char key, unsigned long time)
+{
+    if (_timeout && (time - _lastTime) > _timeout) _state = 0;
+    _lastTime = time;
+
+    byte symbol = 0;
+    while (symbol < _automaton.symbols && (char)pgm_read_byte(_automaton.alphabet + symbol) != key) {
+        symbol++;
+    }
+    if (symbol == _automaton.symbols) {
+        _state = 0;
+        return SEQ_NO_MATCH;
+    }
+
+    _state = pgm_read_byte(_automaton.next + _state * _automaton.symbols + symbol);
+    return (int)pgm_read_byte(_automaton.output + _state) - 1;
+}
+
+/**
+ * @brief Restarts matching from the initial state.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadSequences::reset()
+{
+    _state = 0;
+}
+
+/**
+ * @brief Constructs a PIN entry with no PINs configured.
+ *
+ * @param enterKey Key that submits the entered digits.
+ * @param clearKey Key that discards the entered digits.
+ * @return None
+ */
+KeypadPin::KeypadPin(char enterKey, char clearKey)
+{
+    _enterKey = enterKey;
+    _clearKey = clearKey;
+    memset(_pins, 0, sizeof(_pins));
+    memset(_pinLengths, 0, sizeof(_pinLengths));
+    reset();
+}
+
+/**
+ * @brief Stores a PIN in a slot.
+ *
+ * @param slot Slot number, below KEYPAD_MAX_PINS.
+ * @param pin NUL-terminated PIN of 1 to KEYPAD_PIN_MAX characters.
+ * @return bool True if the PIN was stored.
+ */
+bool KeypadPin::setPin(byte slot, const char *pin)
+{
+    byte length = strlen(pin);
+    if (slot >= KEYPAD_MAX_PINS || !length || length > KEYPAD_PIN_MAX) return false;
+
+    memset(_pins[slot], 0, KEYPAD_PIN_MAX);
+    memcpy(_pins[slot], pin, length);
+    _pinLengths[slot] = length;
+    return true;
+}
+
+/**
+ * @brief Erases the PIN stored in a slot.
+ *
+ * @param slot Slot number, below KEYPAD_MAX_PINS.
+ * @return None
+ */
+void KeypadPin::clearPin(byte slot)
+{
+    if (slot < KEYPAD_MAX_PINS) {
+        memset(_pins[slot], 0, KEYPAD_PIN_MAX);
+        _pinLengths[slot] = 0;
+    }
+}
+
+/**
+ * @brief Sets the maximum gap between two keys of an entry.
+ *
+ * Digits entered before a longer gap are discarded when the next key arrives.
+ *
+ * @param timeout The timeout in milliseconds, 0 to disable.
+ * @return None
+ * @note Updates the member variable `_timeout`.
+ */
+void KeypadPin::setTimeout(unsigned int timeout)
+{
+    _timeout = timeout;
+}
+
+/**
+ * @brief Configures the lockout policy.
+ *
+ * After `maxFailures` consecutive rejected entries, every key is refused until `lockoutTime` has
+ * passed since the last failure. A successful entry resets the failure count.
+ *
+ * @param maxFailures Failures allowed before locking, 0 to disable lockout.
+ * @param lockoutTime Lockout duration in milliseconds.
+ * @return None
+ */
+void KeypadPin::setLockout(byte maxFailures, unsigned long lockoutTime)
+{
+    _maxFailures = maxFailures;
+    _lockoutTime = lockoutTime;
+}
+
+/**
+ * @brief Processes one key of a PIN entry.
+ *
+ * Timeout and lockout are evaluated against the key timestamp, so feeding keys from the event
+ * queue keeps the policy exact even if the sketch polls irregularly.
+ *
+ * @param key The key character.
+ * @param time Timestamp of the key press in milliseconds.
+ * @return byte One of the PIN_* results.
+ */
+byte KeypadPin::feed(char key, unsigned long time)
+{
+    if (isLocked(time)) return PIN_LOCKED;
+
+    if (_timeout && _length && (time - _lastTime) > _timeout) reset();
+    _lastTime = time;
+
+    if (key == _clearKey) {
+        reset();
+        return PIN_CLEARED;
+    }
+
+    if (key == _enterKey) {
+        byte result = verify();
+        reset();
+
+        if (result == PIN_REJECTED && _maxFailures && ++_failures >= _maxFailures) {
+            _locked = true;
+            _lockedAt = time;
+        }
+        if (result == PIN_ACCEPTED) _failures = 0;
+        return result;
+    }
+
+    if (key < '0' || key > '9') return PIN_IGNORED;
+
+    if (_length < KEYPAD_PIN_MAX) _entry[_length++] = key;
+    else _overflow = true;
+    return PIN_ENTERING;
+}
+
+/**
+ * @brief Discards the digits entered so far.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadPin::reset()
+{
+    memset(_entry, 0, KEYPAD_PIN_MAX);
+    _length = 0;
+    _overflow = false;
+}
+
+/**
+ * @brief Checks whether entry is locked out.
+ *
+ * @param now Current time in milliseconds.
+ * @return bool True while the lockout is active.
+ */
+bool KeypadPin::isLocked(unsigned long now)
+{
+    if (_locked && (now - _lockedAt) >= _lockoutTime) {
+        _locked = false;
+        _failures = 0;
+    }
+    return _locked;
+}
+
+/**
+ * @brief Retrieves the slot of the PIN matched by the last accepted entry.
+ *
+ * @param None
+ * @return int The slot number, or -1 if the last entry was not accepted.
+ */
+int KeypadPin::getMatchedPin()
+{
+    return _matched;
+}
+
+/**
+ * @brief Compares the entry against every PIN slot in constant time.
+ *
+ * Each slot is compared over the full KEYPAD_PIN_MAX bytes with the differences OR-ed together,
+ * and all slots are visited regardless of earlier results, so the time taken does not depend on
+ * how many leading digits were correct or which slot matched.
+ *
+ * @param None
+ * @return byte PIN_ACCEPTED or PIN_REJECTED.
+ * @note Updates the member variable `_matched`.
+ */
+byte KeypadPin::verify()
+{
+    int matched = -1;
+
+    for (byte s = 0; s < KEYPAD_MAX_PINS; s++) {
+        byte diff = _pinLengths[s] ^ _length;
+        for (byte i = 0; i < KEYPAD_PIN_MAX; i++) {
+            diff |= _pins[s][i] ^ _entry[i];
+        }
+        diff |= _overflow | !_pinLengths[s];
+
+        // branch-free select of the first matching slot
+        int hit = -(int)(diff == 0) & -(int)(matched < 0);
+        matched = (hit & s) | (~hit & matched);
+    }
+
+    _matched = matched;
+    return (matched >= 0) ? PIN_ACCEPTED : PIN_REJECTED;
+}
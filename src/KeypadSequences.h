@@ -0,0 +1,89 @@
+#pragma once
+#include <Arduino.h>
+
+
+/**
+ * @brief Results returned by KeypadPin::feed().
+ */
+#define PIN_IGNORED     0  ///< Key is not used by PIN entry.
+#define PIN_ENTERING    1  ///< Digit stored, entry in progress.
+#define PIN_ACCEPTED    2  ///< Entry matched a PIN, see getMatchedPin().
+#define PIN_REJECTED    3  ///< Entry did not match any PIN.
+#define PIN_LOCKED      4  ///< Too many failures, entry refused until the lockout expires.
+#define PIN_CLEARED     5  ///< Entry discarded by the clear key.
+
+#define SEQ_NO_MATCH    -1 ///< KeypadSequences::feed() result when no sequence ends at this key.
+
+#ifndef KEYPAD_PIN_MAX
+#define KEYPAD_PIN_MAX      8  ///< Longest PIN in digits.
+#endif
+
+#ifndef KEYPAD_MAX_PINS
+#define KEYPAD_MAX_PINS     4  ///< PIN slots per KeypadPin object.
+#endif
+
+/**
+ * @brief Sequence automaton tables generated by `tools/seqgen.py`.
+ *
+ * `next` is the complete transition table (failure links already folded in) and `output` holds
+ * the sequence id + 1 recognised in each state, so matching is one table read per key. All
+ * tables live in flash (PROGMEM).
+ */
+struct KeypadAutomaton {
+    const char *alphabet;   ///< Keys used by the sequences, PROGMEM string.
+    const uint8_t *next;    ///< `states * symbols` transition table, PROGMEM.
+    const uint8_t *output;  ///< Per-state sequence id + 1, or 0, PROGMEM.
+    byte symbols;           ///< Length of `alphabet`.
+    byte states;            ///< Number of automaton states.
+};
+
+class KeypadSequences {
+    public:
+        KeypadSequences(const KeypadAutomaton &automaton);
+
+        void setTimeout(unsigned int timeout);
+        int feed(char key, unsigned long time);
+        void reset();
+
+    private:
+        const KeypadAutomaton &_automaton;
+        byte _state = 0;
+        unsigned int _timeout = 0;
+        unsigned long _lastTime = 0;
+};
+
+class KeypadPin {
+    public:
+        KeypadPin(char enterKey = '#', char clearKey = '*');
+
+        bool setPin(byte slot, const char *pin);
+        void clearPin(byte slot);
+        void setTimeout(unsigned int timeout);
+        void setLockout(byte maxFailures, unsigned long lockoutTime);
+
+        byte feed(char key, unsigned long time);
+        void reset();
+        bool isLocked(unsigned long now);
+        int getMatchedPin();
+
+    private:
+        char _pins[KEYPAD_MAX_PINS][KEYPAD_PIN_MAX];
+        byte _pinLengths[KEYPAD_MAX_PINS];
+        char _entry[KEYPAD_PIN_MAX];
+        byte _length = 0;
+        bool _overflow = false;
+
+        char _enterKey;
+        char _clearKey;
+        unsigned int _timeout = 5000;
+        unsigned long _lastTime = 0;
+
+        byte _maxFailures = 3;
+        byte _failures = 0;
+        unsigned long _lockoutTime = 30000;
+        unsigned long _lockedAt = 0;
+        bool _locked = false;
+        int _matched = -1;
+
+        byte verify();
+};
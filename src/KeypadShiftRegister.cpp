@@ -0,0 +1,198 @@
+/**
+ * @file KeypadShiftRegister.cpp
+ * @brief Implementation of the KeypadShiftRegister driver for 74HC595 columns and 74HC165 rows.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ */
+
+#include "KeypadShiftRegister.h"
+
+/**
+ * @brief Constructs a driver for columns on chained 74HC595s and rows on chained 74HC165s.
+ *
+ * Column c is output c of the 595 chain (QA of the first register is column 0). Row 0 is input
+ * H of the 165 whose QH feeds the MCU, row 1 input G, and so on down the chain. Rows need
+ * pull-down resistors as with direct pins; the selected column is driven HIGH. The 165 clock
+ * inhibit input must be tied LOW.
+ *
+ * @param dataOut 595 serial data (SER).
+ * @param clockOut 595 shift clock (SRCLK).
+ * @param latchOut 595 storage clock (RCLK).
+ * @param dataIn 165 serial output (QH).
+ * @param clockIn 165 clock (CLK).
+ * @param loadIn 165 parallel load (SH/LD, active LOW).
+ * @return None
+ */
+KeypadShiftRegister::KeypadShiftRegister(byte dataOut, byte clockOut, byte latchOut,
+                                         byte dataIn, byte clockIn, byte loadIn)
+{
+    _dataOut.number = dataOut;
+    _clockOut.number = clockOut;
+    _latchOut.number = latchOut;
+    _dataIn.number = dataIn;
+    _clockIn.number = clockIn;
+    _loadIn.number = loadIn;
+}
+
+/**
+ * @brief Configures the shift register pins and clears every column.
+ *
+ * On AVR the port register and bit mask of each pin are looked up once here, so shifting only
+ * touches the port registers.
+ *
+ * @param numRows Number of rows in the keypad matrix.
+ * @param numCols Number of columns in the keypad matrix.
+ * @return None
+ * @note Uses Arduino `pinMode` function.
+ */
+void KeypadShiftRegister::begin(byte numRows, byte numCols)
+{
+    _numRows = numRows;
+    _numCols = numCols;
+
+    attach(_dataOut, _dataOut.number, true);
+    attach(_clockOut, _clockOut.number, true);
+    attach(_latchOut, _latchOut.number, true);
+    attach(_dataIn, _dataIn.number, false);
+    attach(_clockIn, _clockIn.number, true);
+    attach(_loadIn, _loadIn.number, true);
+
+    write(_loadIn, HIGH);
+    write(_dataOut, LOW);
+    for (byte c = 0; c < _numCols; c++) pulse(_clockOut);
+    pulse(_latchOut);
+    _position = 0xFF;
+}
+
+/**
+ * @brief Drives one column HIGH through the 595 chain.
+ *
+ * Scanning in order only needs one shift clock per column: the walking one moves to the next
+ * output. Any other column reloads the whole chain.
+ *
+ * @param col Column number.
+ * @return None
+ */
+void KeypadShiftRegister::select(byte col)
+{
+    if (col == (byte)(_position + 1) && col) {
+        write(_dataOut, LOW);
+        pulse(_clockOut);
+    } else {
+        for (byte c = _numCols; c-- > 0;) {
+            write(_dataOut, c == col);
+            pulse(_clockOut);
+        }
+    }
+    pulse(_latchOut);
+    _position = col;
+}
+
+/**
+ * @brief Returns the settle time of a column.
+ *
+ * @param col Column number.
+ * @return unsigned int KEYPAD_SETTLE_US.
+ */
+unsigned int KeypadShiftRegister::settleTime(byte col)
+{
+    (void)col;
+    return KEYPAD_SETTLE_US;
+}
+
+/**
+ * @brief Latches every row into the 165 chain and shifts them in.
+ *
+ * @param None
+ * @return KeypadLineMask Bit r set for each row that reads HIGH.
+ */
+KeypadLineMask KeypadShiftRegister::read()
+{
+    KeypadLineMask rows = 0;
+
+    write(_loadIn, LOW);
+    write(_loadIn, HIGH);
+
+    for (byte r = 0; r < _numRows; r++) {
+        if (sample(_dataIn)) rows |= (KeypadLineMask)1 << r;
+        pulse(_clockIn);
+    }
+    return rows;
+}
+
+/**
+ * @brief Leaves the column in place; the next select() moves or reloads the walking one.
+ *
+ * @param col Column number.
+ * @return None
+ */
+void KeypadShiftRegister::deselect(byte col)
+{
+    (void)col;
+}
+
+/**
+ * @brief Sets the pin mode and caches the port access of a pin.
+ *
+ * @param pin The pin record to fill.
+ * @param number Arduino pin number.
+ * @param output True for an output pin.
+ * @return None
+ */
+void KeypadShiftRegister::attach(Pin &pin, byte number, bool output)
+{
+    pinMode(number, output ? OUTPUT : INPUT);
+    pin.number = number;
+#if defined(__AVR__)
+    uint8_t port = digitalPinToPort(number);
+    pin.reg = output ? portOutputRegister(port) : portInputRegister(port);
+    pin.mask = digitalPinToBitMask(number);
+#endif
+}
+
+/**
+ * @brief Writes an output pin, through its port register on AVR.
+ *
+ * @param pin The pin.
+ * @param value HIGH or LOW.
+ * @return None
+ */
+void KeypadShiftRegister::write(const Pin &pin, bool value)
+{
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+    if (value) *pin.reg |= pin.mask;
+    else *pin.reg &= ~pin.mask;
+    SREG = oldSREG;
+#else
+    digitalWrite(pin.number, value ? HIGH : LOW);
+#endif
+}
+
+/**
+ * @brief Reads an input pin, through its port register on AVR.
+ *
+ * @param pin The pin.
+ * @return bool True if the pin is HIGH.
+ */
+bool KeypadShiftRegister::sample(const Pin &pin)
+{
+#if defined(__AVR__)
+    return (*pin.reg & pin.mask) != 0;
+#else
+    return digitalRead(pin.number) == HIGH;
+#endif
+}
+
+/**
+ * @brief Pulses a clock or latch pin HIGH then LOW.
+ *
+ * @param pin The pin.
+ * @return None
+ */
+void KeypadShiftRegister::pulse(const Pin &pin)
+{
+    write(pin, HIGH);
+    write(pin, LOW);
+}
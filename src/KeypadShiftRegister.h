@@ -0,0 +1,41 @@
+#pragma once
+#include <Arduino.h>
+#include "KeypadDriver.h"
+
+
+class KeypadShiftRegister : public KeypadDriver {
+    public:
+        KeypadShiftRegister(byte dataOut, byte clockOut, byte latchOut,
+                            byte dataIn, byte clockIn, byte loadIn);
+
+        void begin(byte numRows, byte numCols) override;
+        void select(byte col) override;
+        unsigned int settleTime(byte col) override;
+        KeypadLineMask read() override;
+        void deselect(byte col) override;
+
+    private:
+        struct Pin {
+            byte number;
+#if defined(__AVR__)
+            volatile uint8_t *reg;
+            uint8_t mask;
+#endif
+        };
+
+        Pin _dataOut;
+        Pin _clockOut;
+        Pin _latchOut;
+        Pin _dataIn;
+        Pin _clockIn;
+        Pin _loadIn;
+
+        byte _numRows = 0;
+        byte _numCols = 0;
+        byte _position = 0xFF;  // column currently holding the walking one
+
+        void attach(Pin &pin, byte number, bool output);
+        void write(const Pin &pin, bool value);
+        bool sample(const Pin &pin);
+        void pulse(const Pin &pin);
+};
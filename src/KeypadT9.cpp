@@ -0,0 +1,414 @@
+/**
+ * @file KeypadT9.cpp
+ * @brief Implementation of the KeypadT9 class for multi-tap and predictive text entry.
+ * @author Sheikh Fardin Hossen Araf, Embedded System Engineer
+ * @version 1.0.0
+ *
+ * Predictive mode walks a digit trie stored in flash. The blob is produced on the host by
+ * `tools/t9pack.py` and has the layout below (all offsets are absolute, little-endian):
+ *
+ *     header : 'T' '9' version reserved
+ *     node   : childMask wordCount child[popcount(childMask)] word[wordCount]
+ *
+ * `childMask` bit (d - 2) is set when digit d ('2'..'9') has a child node, `child[]` holds
+ * 16-bit offsets of those children in digit order and `word[]` holds NUL-terminated words,
+ * most frequent first. Each keystroke descends one edge, so lookup never rescans the sequence.
+ */
+
+#include "KeypadT9.h"
+
+static const char T9_LETTERS[8][5] PROGMEM = {
+    "abc", "def", "ghi", "jkl", "mno", "pqrs", "tuv", "wxyz"
+};
+
+/**
+ * @brief Constructs a KeypadT9 text entry object.
+ *
+ * Starts in multi-tap mode with empty text. Predictive mode is only available when a dictionary
+ * generated by `tools/t9pack.py` is supplied.
+ *
+ * @param dictionary Packed T9 dictionary in flash (PROGMEM), or nullptr for multi-tap only.
+ * @return None
+ */
+KeypadT9::KeypadT9(const uint8_t *dictionary)
+{
+    _dict = nullptr;
+    if (dictionary &&
+        pgm_read_byte(dictionary) == T9_DICT_MAGIC0 &&
+        pgm_read_byte(dictionary + 1) == T9_DICT_MAGIC1 &&
+        pgm_read_byte(dictionary + 2) == T9_DICT_VERSION) {
+        _dict = dictionary;
+    }
+    clear();
+}
+
+/**
+ * @brief Selects the text entry mode.
+ *
+ * Commits any word or letter being composed before switching. Predictive mode falls back to
+ * multi-tap when no valid dictionary was supplied.
+ *
+ * @param mode T9_MODE_MULTITAP or T9_MODE_PREDICTIVE.
+ * @return None
+ */
+void KeypadT9::setMode(byte mode)
+{
+    commit();
+    _mode = (mode == T9_MODE_PREDICTIVE && _dict) ? T9_MODE_PREDICTIVE : T9_MODE_MULTITAP;
+}
+
+/**
+ * @brief Retrieves the active text entry mode.
+ *
+ * @param None
+ * @return byte T9_MODE_MULTITAP or T9_MODE_PREDICTIVE.
+ */
+byte KeypadT9::getMode()
+{
+    return _mode;
+}
+
+/**
+ * @brief Sets the multi-tap timeout.
+ *
+ * A letter is committed when its key has not been pressed again within this interval.
+ *
+ * @param timeout The timeout in milliseconds.
+ * @return None
+ * @note Updates the member variable `_tapTimeout`.
+ */
+void KeypadT9::setMultiTapTimeout(unsigned int timeout)
+{
+    _tapTimeout = timeout;
+}
+
+/**
+ * @brief Feeds a key from `CustomKeypad::getKey()` or the event queue using the default layout.
+ *
+ * Digits '2'..'9' enter letters, '0' commits and inserts a space, '*' cycles through the
+ * predictive candidates and '#' deletes. Other keys are ignored.
+ *
+ * @param key The key character.
+ * @param now Timestamp of the key press in milliseconds.
+ * @return bool True if the text or composition changed.
+ */
+bool KeypadT9::handleKey(char key, unsigned long now)
+{
+    if (key >= '2' && key <= '9') return press(key, now);
+
+    switch (key) {
+        case '0':
+            commit();
+            append(' ');
+            return true;
+        case '*':
+            return nextCandidate();
+        case '#':
+            return backspace();
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Enters a digit.
+ *
+ * In multi-tap mode, pressing the same digit within the timeout cycles its letters, otherwise the
+ * pending letter is committed first. In predictive mode, the digit descends one level of the
+ * dictionary trie, so the cost per keystroke is constant.
+ *
+ * @param digit A digit between '2' and '9'.
+ * @param now Timestamp of the key press in milliseconds.
+ * @return bool True if the composition changed.
+ */
+bool KeypadT9::press(char digit, unsigned long now)
+{
+    if (digit < '2' || digit > '9') return false;
+
+    if (_mode == T9_MODE_MULTITAP) {
+        if (_tapKey == digit && (now - _tapTime) < _tapTimeout) {
+            _tapCount++;
+        } else {
+            commit();
+            _tapKey = digit;
+            _tapCount = 0;
+        }
+        _tapTime = now;
+        composeTap();
+        return true;
+    }
+
+    if (_depth >= KEYPAD_T9_MAX_WORD) return false;
+
+    _digits[_depth] = digit;
+    _path[_depth + 1] = child(_path[_depth], digit);
+    _depth++;
+    _candidate = 0;
+    composeWord();
+    return true;
+}
+
+/**
+ * @brief Selects the next predictive candidate for the current digit sequence.
+ *
+ * Wraps around to the most frequent word after the last candidate.
+ *
+ * @param None
+ * @return bool True if a different candidate was selected.
+ */
+bool KeypadT9::nextCandidate()
+{
+    byte count = getCandidateCount();
+    if (_mode != T9_MODE_PREDICTIVE || count < 2) return false;
+
+    _candidate = (_candidate + 1) % count;
+    composeWord();
+    return true;
+}
+
+/**
+ * @brief Deletes the last digit of the composition, or the last committed character.
+ *
+ * In predictive mode the trie path is kept per digit, so removing a digit is a pop.
+ *
+ * @param None
+ * @return bool True if anything was deleted.
+ */
+bool KeypadT9::backspace()
+{
+    if (_mode == T9_MODE_PREDICTIVE && _depth) {
+        _depth--;
+        _candidate = 0;
+        composeWord();
+        return true;
+    }
+    if (_mode == T9_MODE_MULTITAP && _tapKey) {
+        _tapKey = 0;
+        _word[0] = 0;
+        return true;
+    }
+    if (_textLen) {
+        _text[--_textLen] = 0;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Commits a pending multi-tap letter once its timeout has elapsed.
+ *
+ * Call periodically from `loop()` so the letter is accepted without waiting for the next press.
+ *
+ * @param now Current time in milliseconds.
+ * @return bool True if a letter was committed.
+ */
+bool KeypadT9::poll(unsigned long now)
+{
+    if (_mode == T9_MODE_MULTITAP && _tapKey && (now - _tapTime) >= _tapTimeout) {
+        commit();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Appends the current composition to the text and starts a new one.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadT9::commit()
+{
+    for (byte i = 0; _word[i]; i++) append(_word[i]);
+
+    _word[0] = 0;
+    _tapKey = 0;
+    _tapCount = 0;
+    _depth = 0;
+    _candidate = 0;
+}
+
+/**
+ * @brief Discards the text and any composition in progress.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadT9::clear()
+{
+    _text[0] = 0;
+    _textLen = 0;
+    _word[0] = 0;
+    _tapKey = 0;
+    _tapCount = 0;
+    _depth = 0;
+    _candidate = 0;
+    _path[0] = _dict ? T9_DICT_ROOT : T9_NO_NODE;
+}
+
+/**
+ * @brief Retrieves the committed text.
+ *
+ * @param None
+ * @return const char* NUL-terminated committed text.
+ */
+const char *KeypadT9::getText()
+{
+    return _text;
+}
+
+/**
+ * @brief Retrieves the word or letter currently being composed.
+ *
+ * In predictive mode this is the selected candidate. When the sequence has no complete word yet,
+ * it is the prefix of the first longer word in the trie, and when the sequence has left the
+ * dictionary the first letter of each key is shown instead.
+ *
+ * @param None
+ * @return const char* NUL-terminated composition, empty when idle.
+ */
+const char *KeypadT9::getComposition()
+{
+    return _word;
+}
+
+/**
+ * @brief Retrieves the number of dictionary words matching the current digit sequence.
+ *
+ * @param None
+ * @return byte The number of candidates, 0 when there is no exact match.
+ */
+byte KeypadT9::getCandidateCount()
+{
+    if (_mode != T9_MODE_PREDICTIVE || !_depth) return 0;
+    return wordCount(_path[_depth]);
+}
+
+/**
+ * @brief Appends a character to the committed text, dropping it when the buffer is full.
+ *
+ * @param c The character to append.
+ * @return None
+ */
+void KeypadT9::append(char c)
+{
+    if (_textLen < KEYPAD_T9_MAX_TEXT) {
+        _text[_textLen++] = c;
+        _text[_textLen] = 0;
+    }
+}
+
+/**
+ * @brief Rebuilds the composition from the pending multi-tap key and tap count.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadT9::composeTap()
+{
+    const char *letters = T9_LETTERS[_tapKey - '2'];
+    byte n = strlen_P(letters);
+
+    _word[0] = pgm_read_byte(letters + (_tapCount % n));
+    _word[1] = 0;
+}
+
+/**
+ * @brief Rebuilds the composition from the current trie node and candidate index.
+ *
+ * @param None
+ * @return None
+ */
+void KeypadT9::composeWord()
+{
+    byte len = 0;
+    uint16_t node = _path[_depth];
+
+    if (_depth && node != T9_NO_NODE) {
+        uint16_t word = firstWord(node);
+        byte count = wordCount(node);
+
+        if (count) {
+            for (byte i = 0; i < _candidate; i++) {
+                while (pgm_read_byte(_dict + word++)) {}
+            }
+        } else {
+            // no exact match yet: show the prefix of the first completion
+            while (!wordCount(node)) {
+                byte mask = pgm_read_byte(_dict + node);
+                if (!mask) break;
+                node = read16(node + 2);
+            }
+            word = firstWord(node);
+        }
+
+        for (; len < _depth; len++) {
+            char c = pgm_read_byte(_dict + word + len);
+            if (!c) break;
+            _word[len] = c;
+        }
+    } else {
+        for (; len < _depth; len++) {
+            _word[len] = pgm_read_byte(T9_LETTERS[_digits[len] - '2']);
+        }
+    }
+
+    _word[len] = 0;
+}
+
+/**
+ * @brief Follows the trie edge for a digit.
+ *
+ * The child slot is found with a popcount over the lower bits of the child mask, so the step
+ * costs the same regardless of dictionary size.
+ *
+ * @param node Offset of the current node, or T9_NO_NODE.
+ * @param digit A digit between '2' and '9'.
+ * @return uint16_t Offset of the child node, or T9_NO_NODE if the sequence left the dictionary.
+ */
+uint16_t KeypadT9::child(uint16_t node, char digit)
+{
+    if (node == T9_NO_NODE) return T9_NO_NODE;
+
+    byte bit = digit - '2';
+    byte mask = pgm_read_byte(_dict + node);
+    if (!(mask & (1 << bit))) return T9_NO_NODE;
+
+    byte slot = __builtin_popcount(mask & ((1 << bit) - 1));
+    return read16(node + 2 + 2 * slot);
+}
+
+/**
+ * @brief Retrieves the number of words stored at a trie node.
+ *
+ * @param node Offset of the node, or T9_NO_NODE.
+ * @return byte The word count.
+ */
+byte KeypadT9::wordCount(uint16_t node)
+{
+    if (node == T9_NO_NODE) return 0;
+    return pgm_read_byte(_dict + node + 1);
+}
+
+/**
+ * @brief Retrieves the offset of the first word stored at a trie node.
+ *
+ * @param node Offset of the node.
+ * @return uint16_t Offset of the first NUL-terminated word.
+ */
+uint16_t KeypadT9::firstWord(uint16_t node)
+{
+    byte mask = pgm_read_byte(_dict + node);
+    return node + 2 + 2 * __builtin_popcount(mask);
+}
+
+/**
+ * @brief Reads a little-endian 16-bit value from the dictionary.
+ *
+ * @param offset Offset of the value in the dictionary.
+ * @return uint16_t The value.
+ */
+uint16_t KeypadT9::read16(uint16_t offset)
+{
+    return pgm_read_byte(_dict + offset) | (pgm_read_byte(_dict + offset + 1) << 8);
+}
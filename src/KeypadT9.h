@@ -0,0 +1,72 @@
+#pragma once
+#include <Arduino.h>
+
+
+/**
+ * @brief Text entry modes supported by KeypadT9.
+ */
+#define T9_MODE_MULTITAP    0  ///< Classic multi-tap: repeated presses cycle through a key's letters.
+#define T9_MODE_PREDICTIVE  1  ///< One press per letter, words looked up in a packed dictionary.
+
+#ifndef KEYPAD_T9_MAX_WORD
+#define KEYPAD_T9_MAX_WORD  16  ///< Longest digit sequence tracked in predictive mode.
+#endif
+
+#ifndef KEYPAD_T9_MAX_TEXT
+#define KEYPAD_T9_MAX_TEXT  32  ///< Capacity of the committed text buffer.
+#endif
+
+#define T9_DICT_MAGIC0      'T'
+#define T9_DICT_MAGIC1      '9'
+#define T9_DICT_VERSION     1
+#define T9_DICT_ROOT        4       ///< Offset of the root node, right after the 4-byte header.
+#define T9_NO_NODE          0xFFFF  ///< Path entry for a digit sequence that left the dictionary.
+
+class KeypadT9 {
+    public:
+        KeypadT9(const uint8_t *dictionary = nullptr);
+
+        void setMode(byte mode);
+        byte getMode();
+        void setMultiTapTimeout(unsigned int timeout);
+
+        bool handleKey(char key, unsigned long now);
+        bool press(char digit, unsigned long now);
+        bool nextCandidate();
+        bool backspace();
+        bool poll(unsigned long now);
+        void commit();
+        void clear();
+
+        const char *getText();
+        const char *getComposition();
+        byte getCandidateCount();
+
+    private:
+        const uint8_t *_dict;
+        byte _mode = T9_MODE_MULTITAP;
+        unsigned int _tapTimeout = 1000;
+
+        char _text[KEYPAD_T9_MAX_TEXT + 1];
+        byte _textLen = 0;
+        char _word[KEYPAD_T9_MAX_WORD + 1];
+
+        // multi-tap
+        char _tapKey = 0;
+        byte _tapCount = 0;
+        unsigned long _tapTime = 0;
+
+        // predictive
+        char _digits[KEYPAD_T9_MAX_WORD];
+        uint16_t _path[KEYPAD_T9_MAX_WORD + 1];
+        byte _depth = 0;
+        byte _candidate = 0;
+
+        void append(char c);
+        void composeTap();
+        void composeWord();
+        uint16_t child(uint16_t node, char digit);
+        byte wordCount(uint16_t node);
+        uint16_t firstWord(uint16_t node);
+        uint16_t read16(uint16_t offset);
+};
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Compile key sequences into the Aho-Corasick automaton used by KeypadSequences.
+
+Input is a text file with one sequence per line, a name followed by the keys:
+
+    SERVICE  *#06#
+    RESET    *#99#
+    TEST     ##
+
+Sequence ids follow the input order and are emitted as SEQ_<NAME> defines. When several
+sequences end on the same key, the longest one is reported.
+
+The output is a C header with PROGMEM tables and a KeypadAutomaton named after -n:
+
+    python3 tools/seqgen.py codes.txt -o Sequences.h -n CODES
+"""
+
+import argparse
+import sys
+from collections import deque
+
+
+def load(path):
+    sequences = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            parts = line.split()
+            if not parts or parts[0].startswith("#"):
+                continue
+            if len(parts) != 2:
+                sys.exit("seqgen: expected 'NAME KEYS', got: %s" % line.strip())
+            sequences.append((parts[0].upper(), parts[1]))
+    if not sequences:
+        sys.exit("seqgen: no sequences in %s" % path)
+    return sequences
+
+
+def build(sequences):
+    alphabet = sorted({k for _, keys in sequences for k in keys})
+    goto = [{}]
+    depth = [0]
+    output = [None]
+
+    for ident, (_, keys) in enumerate(sequences):
+        state = 0
+        for k in keys:
+            if k not in goto[state]:
+                goto.append({})
+                depth.append(depth[state] + 1)
+                output.append(None)
+                goto[state][k] = len(goto) - 1
+            state = goto[state][k]
+        output[state] = ident
+
+    # breadth-first: failure links, then fold them into a complete transition table
+    fail = [0] * len(goto)
+    table = [[0] * len(alphabet) for _ in goto]
+    queue = deque()
+    for s, k in enumerate(alphabet):
+        child = goto[0].get(k)
+        if child is not None:
+            table[0][s] = child
+            queue.append(child)
+    while queue:
+        state = queue.popleft()
+        if output[state] is None and output[fail[state]] is not None:
+            output[state] = output[fail[state]]
+        for s, k in enumerate(alphabet):
+            child = goto[state].get(k)
+            if child is None:
+                table[state][s] = table[fail[state]][s]
+            else:
+                fail[child] = table[fail[state]][s]
+                table[state][s] = child
+                queue.append(child)
+
+    if len(goto) > 255:
+        sys.exit("seqgen: %d states, the format is limited to 255" % len(goto))
+    return "".join(alphabet), table, [0 if o is None else o + 1 for o in output]
+
+
+def c_char(c):
+    return "\\\\" if c == "\\" else '\\"' if c == '"' else c
+
+
+def emit(sequences, alphabet, table, output, name, source):
+    lines = [
+        "// Generated by tools/seqgen.py from %s (%d sequences, %d states). Do not edit." % (
+            source, len(sequences), len(table)),
+        "#pragma once",
+        "#include <KeypadSequences.h>",
+        "",
+    ]
+    for ident, (seq_name, keys) in enumerate(sequences):
+        lines.append("#define SEQ_%s %d  // %s" % (seq_name, ident, keys))
+    lines += [
+        "",
+        'const char %s_ALPHABET[] PROGMEM = "%s";' % (name, "".join(c_char(c) for c in alphabet)),
+        "",
+        "const uint8_t %s_NEXT[] PROGMEM = {" % name,
+    ]
+    for row in table:
+        lines.append("    " + ", ".join("%3d" % n for n in row) + ",")
+    lines += [
+        "};",
+        "",
+        "const uint8_t %s_OUTPUT[] PROGMEM = {" % name,
+        "    " + ", ".join(str(o) for o in output),
+        "};",
+        "",
+        "const KeypadAutomaton %s = { %s_ALPHABET, %s_NEXT, %s_OUTPUT, %d, %d };" % (
+            name, name, name, name, len(alphabet), len(table)),
+    ]
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("sequences", help="sequence file, one 'NAME KEYS' per line")
+    parser.add_argument("-o", "--output", help="output header (default: stdout)")
+    parser.add_argument("-n", "--name", default="SEQUENCES", help="C name of the automaton")
+    args = parser.parse_args()
+
+    sequences = load(args.sequences)
+    alphabet, table, output = build(sequences)
+    text = emit(sequences, alphabet, table, output, args.name, args.sequences.split("/")[-1])
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Compile a word list into the packed T9 dictionary used by KeypadT9.
+
+Input is a text file with one word per line, optionally followed by a frequency:
+
+    hello 120
+    good 95
+    home
+
+Words are lower-cased; words containing characters outside a-z are skipped. Within a digit
+sequence, candidates are ordered by descending frequency, then by input order.
+
+The output is a C header holding a PROGMEM byte array in the format documented in
+src/KeypadT9.cpp:
+
+    python3 tools/t9pack.py words.txt -o T9Dictionary.h -n T9_DICTIONARY
+"""
+
+import argparse
+import sys
+
+KEYS = {c: d for d, letters in zip("23456789", ["abc", "def", "ghi", "jkl", "mno", "pqrs", "tuv", "wxyz"])
+        for c in letters}
+MAGIC = b"T9"
+VERSION = 1
+HEADER_SIZE = 4
+MAX_WORDS_PER_NODE = 255
+
+
+class Node:
+    def __init__(self):
+        self.children = {}
+        self.words = []
+
+    def size(self):
+        return 2 + 2 * len(self.children) + sum(len(w) + 1 for _, _, w in self.words)
+
+
+def load(path, max_len):
+    root = Node()
+    count = 0
+    with open(path, encoding="utf-8") as f:
+        for order, line in enumerate(f):
+            parts = line.split()
+            if not parts:
+                continue
+            word = parts[0].lower()
+            freq = int(parts[1]) if len(parts) > 1 else 0
+            if not word.isascii() or not word.isalpha() or len(word) > max_len:
+                continue
+            node = root
+            for c in word:
+                node = node.children.setdefault(KEYS[c], Node())
+            if any(w == word for _, _, w in node.words):
+                continue
+            node.words.append((-freq, order, word))
+            count += 1
+    return root, count
+
+
+def layout(root):
+    """Assign offsets in depth-first pre-order and return the nodes in that order."""
+    order = []
+    offset = HEADER_SIZE
+
+    def visit(node):
+        nonlocal offset
+        node.words.sort()
+        if len(node.words) > MAX_WORDS_PER_NODE:
+            node.words = node.words[:MAX_WORDS_PER_NODE]
+        node.offset = offset
+        offset += node.size()
+        order.append(node)
+        for digit in sorted(node.children):
+            visit(node.children[digit])
+
+    visit(root)
+    return order, offset
+
+
+def pack(root):
+    nodes, total = layout(root)
+    if total > 0xFFFF:
+        sys.exit("t9pack: dictionary is %d bytes, the format is limited to 65535" % total)
+
+    out = bytearray(MAGIC)
+    out += bytes([VERSION, 0])
+    for node in nodes:
+        mask = 0
+        for digit in node.children:
+            mask |= 1 << (int(digit) - 2)
+        out += bytes([mask, len(node.words)])
+        for digit in sorted(node.children):
+            out += node.children[digit].offset.to_bytes(2, "little")
+        for _, _, word in node.words:
+            out += word.encode("ascii") + b"\0"
+    assert len(out) == total
+    return out
+
+
+def emit(data, name, source, words):
+    lines = [
+        "// Generated by tools/t9pack.py from %s (%d words, %d bytes). Do not edit." % (source, words, len(data)),
+        "#pragma once",
+        "#include <Arduino.h>",
+        "",
+        "const uint8_t %s[] PROGMEM = {" % name,
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("wordlist", help="word list, one word per line with optional frequency")
+    parser.add_argument("-o", "--output", help="output header (default: stdout)")
+    parser.add_argument("-n", "--name", default="T9_DICTIONARY", help="C array name")
+    parser.add_argument("--max-length", type=int, default=16,
+                        help="skip words longer than this (match KEYPAD_T9_MAX_WORD)")
+    args = parser.parse_args()
+
+    root, words = load(args.wordlist, args.max_length)
+    text = emit(pack(root), args.name, args.wordlist.split("/")[-1], words)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()